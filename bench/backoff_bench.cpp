@@ -0,0 +1,46 @@
+#include "bench_util.h"
+
+#include "lockfree_backoff.h"
+#include "lockfree_silist.h"
+
+// Every thread pushes and pops at the head of a marked list, then appends to a default list and removes its node
+// again, so every operation retries on the same CAS. Runs the thread sweep once per backoff policy,
+// e.g. BENCH_MAX_THREADS=400 for the oversubscription of demo02.
+
+template<typename BACKOFF>
+void runBackoffBench(const std::string& name) {
+    for (int threads : BenchThreadCounts()) {
+        LockFreeSiList<uint64_t, SharedPtrReclaim, LockFreeMarkedNode, ExactCounter, CompactLayout, BACKOFF> stack;
+        RunBench(name + " marked insert/pop head", threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                stack.InsertHead(make_shared<LockFreeMarkedNode<uint64_t>>(index));
+                stack.PopHead();
+                ops += 2;
+            }
+            return ops;
+        });
+    }
+
+    for (int threads : BenchThreadCounts()) {
+        LockFreeSiList<uint64_t, SharedPtrReclaim, LockFreeNode, ExactCounter, CompactLayout, BACKOFF> list;
+        RunBench(name + " append/remove", threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto node = make_shared<LockFreeNode<uint64_t>>(index);
+                list.Append(node);
+                list.Remove(node);
+                ops += 2;
+            }
+            return ops;
+        });
+    }
+}
+
+int main() {
+    runBackoffBench<NoBackoff>("no backoff");
+    runBackoffBench<ExponentialBackoff<>>("exponential");
+    runBackoffBench<SpinYieldBackoff<>>("spin then yield");
+    runBackoffBench<AdaptiveBackoff<>>("adaptive");
+    return 0;
+}
@@ -0,0 +1,106 @@
+#ifndef BENCH_UTIL_H__
+#define BENCH_UTIL_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Minimal benchmark harness: every worker runs body(threadIndex, stop) until stop is set
+ * and returns the number of operations it completed.
+ */
+using BenchBody = std::function<uint64_t(int threadIndex, const std::atomic<bool>& stop)>;
+
+struct BenchResult {
+    std::string name;
+    int threads;
+    uint64_t ops;
+    double seconds;
+
+    double OpsPerSecond() const {
+        return seconds > 0 ? ops / seconds : 0;
+    }
+
+    double NanosPerOp() const {
+        return ops > 0 ? seconds * 1e9 * threads / ops : 0;
+    }
+};
+
+inline int BenchDurationMs() {
+    const char* env = std::getenv("BENCH_DURATION_MS");
+    return env != nullptr ? std::atoi(env) : 500;
+}
+
+inline std::vector<int> BenchThreadCounts() {
+    std::vector<int> counts;
+    int maxThreads = std::thread::hardware_concurrency();
+    const char* env = std::getenv("BENCH_MAX_THREADS");
+    if (env != nullptr)
+        maxThreads = std::atoi(env);
+    if (maxThreads < 1)
+        maxThreads = 1;
+    for (int count = 1; count < maxThreads; count *= 2)
+        counts.push_back(count);
+    counts.push_back(maxThreads);
+    return counts;
+}
+
+/**
+ * The list sizes of the size sweeps, BENCH_LIST_SIZES=100,10000 by default.
+ */
+inline std::vector<int> BenchListSizes() {
+    std::vector<int> sizes;
+    const char* env = std::getenv("BENCH_LIST_SIZES");
+    std::string list = env != nullptr ? env : "100,10000";
+    size_t begin = 0;
+    while (begin < list.size()) {
+        size_t end = list.find(',', begin);
+        if (end == std::string::npos)
+            end = list.size();
+        int size = std::atoi(list.substr(begin, end - begin).c_str());
+        if (size > 0)
+            sizes.push_back(size);
+        begin = end + 1;
+    }
+    return sizes;
+}
+
+inline void PrintBenchResult(const BenchResult& result) {
+    printf("%-56s threads=%3d  ops/s=%14.0f  ns/op=%10.1f\n", result.name.c_str(), result.threads,
+           result.OpsPerSecond(), result.NanosPerOp());
+    fflush(stdout);
+}
+
+inline BenchResult RunBench(const std::string& name, int threads, const BenchBody& body) {
+    std::atomic<bool> start(false);
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> totalOps(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(std::thread([&, i]() {
+            while (!start.load())
+                std::this_thread::yield();
+            totalOps.fetch_add(body(i, stop));
+        }));
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    start.store(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(BenchDurationMs()));
+    stop.store(true);
+    for (auto& worker : workers)
+        worker.join();
+    auto end = std::chrono::steady_clock::now();
+
+    BenchResult result{name, threads, totalOps.load(), std::chrono::duration<double>(end - begin).count()};
+    PrintBenchResult(result);
+    return result;
+}
+
+#endif
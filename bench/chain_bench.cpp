@@ -0,0 +1,55 @@
+#include "bench_util.h"
+
+#include "epoch_reclaim.h"
+#include "lockfree_bilist.h"
+#include "lockfree_silist.h"
+
+// Every thread builds batches of new records and appends them one Append per record, or links the batch
+// privately and publishes it with one AppendChain. Counts records, on epoch reclaimed raw pointer nodes.
+
+template<typename LIST, typename NODE>
+void runChainBench(const std::string& name, int batchSize) {
+    for (int threads : BenchThreadCounts()) {
+        LIST list;
+        RunBench(name + " append batch=" + std::to_string(batchSize), threads,
+                 [&](int index, const std::atomic<bool>& stop) {
+            uint64_t records = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < batchSize; i++)
+                    list.Append(EpochPtr<NODE>(new NODE(index)));
+                records += batchSize;
+            }
+            return records;
+        });
+    }
+
+    for (int threads : BenchThreadCounts()) {
+        LIST list;
+        RunBench(name + " append chain batch=" + std::to_string(batchSize), threads,
+                 [&](int index, const std::atomic<bool>& stop) {
+            uint64_t records = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                EpochPtr<NODE> first(new NODE(index));
+                EpochPtr<NODE> last = first;
+                for (int i = 1; i < batchSize; i++) {
+                    EpochPtr<NODE> node(new NODE(index));
+                    last->SetNext(node);
+                    last = node;
+                }
+                list.AppendChain(first, last, batchSize);
+                records += batchSize;
+            }
+            return records;
+        });
+    }
+}
+
+int main() {
+    for (int batchSize : {16, 256}) {
+        runChainBench<LockFreeSiList<uint64_t, EpochReclaim>, LockFreeNode<uint64_t, EpochReclaim>>(
+            "silist epoch", batchSize);
+        runChainBench<LockFreeBiList<uint64_t, EpochReclaim>, LockFreeBiNode<uint64_t, EpochReclaim>>(
+            "bilist epoch", batchSize);
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+#include "bench_util.h"
+
+#include "lockfree_combining.h"
+#include "lockfree_silist.h"
+
+// Every thread appends a node and pops the head, with the combining list forced lock-free, forced combining and
+// adaptive. The marked list runs all three, the default list only combines: lock-free it takes one remover per end.
+
+template<typename LIST, typename NODE>
+void runCombiningBench(const std::string& name, CombiningMode mode) {
+    for (int threads : BenchThreadCounts()) {
+        LockFreeCombiningList<LIST> list(mode);
+        RunBench(name, threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                list.Append(make_shared<NODE>(index));
+                list.PopHead();
+                ops += 2;
+            }
+            return ops;
+        });
+    }
+}
+
+int main() {
+    using MarkedList = LockFreeSiList<uint64_t, SharedPtrReclaim, LockFreeMarkedNode, ExactCounter, CompactLayout,
+                                      CountingBackoff<>>;
+    using DefaultList = LockFreeSiList<uint64_t, SharedPtrReclaim, LockFreeNode, ExactCounter, CompactLayout,
+                                       CountingBackoff<>>;
+    runCombiningBench<MarkedList, LockFreeMarkedNode<uint64_t>>("silist marked lock-free", CombiningMode::kLockFree);
+    runCombiningBench<MarkedList, LockFreeMarkedNode<uint64_t>>("silist marked combining", CombiningMode::kCombining);
+    runCombiningBench<MarkedList, LockFreeMarkedNode<uint64_t>>("silist marked adaptive", CombiningMode::kAdaptive);
+    runCombiningBench<DefaultList, LockFreeNode<uint64_t>>("silist combining", CombiningMode::kCombining);
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "bench_util.h"
+
+#include "lockfree_bilist.h"
+#include "lockfree_counter.h"
+
+// Compares the counting policies: every thread inserts and removes its own node next to a private anchor node,
+// so the size counter is the only cache line all threads write to.
+
+template<typename COUNTER>
+void runCounterBench(const std::string& name) {
+    for (int threads : BenchThreadCounts()) {
+        COUNTER counter;
+        RunBench(name + " add", threads, [&](int, const std::atomic<bool>& stop) {
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                counter.Add(1);
+                ops++;
+            }
+            return ops;
+        });
+    }
+
+    using ListType = LockFreeBiList<uint64_t, SharedPtrReclaim, LockFreeBiNode, COUNTER>;
+    using NodeType = LockFreeBiNode<uint64_t>;
+    for (int threads : BenchThreadCounts()) {
+        ListType list;
+        std::vector<shared_ptr<NodeType>> anchors;
+        for (int i = 0; i < threads; i++) {
+            anchors.push_back(make_shared<NodeType>(i));
+            list.Append(anchors.back());
+        }
+        RunBench(name + " insert/remove middle", threads, [&](int index, const std::atomic<bool>& stop) {
+            shared_ptr<NodeType> node = make_shared<NodeType>(index);
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                list.Insert(node, anchors[index]);
+                list.Remove(node);
+                ops += 2;
+            }
+            return ops;
+        });
+    }
+}
+
+int main() {
+    runCounterBench<ExactCounter>("exact counter");
+    runCounterBench<ShardedCounter>("sharded counter");
+    runCounterBench<NoCounter>("no counter");
+    return 0;
+}
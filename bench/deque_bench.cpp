@@ -0,0 +1,69 @@
+#include "bench_util.h"
+
+#include "lockfree_deque.h"
+
+// Push and pop at the front only, at the back only, and at both ends (even threads at the front, odd threads at the
+// back) of a deque holding listSize nodes, against InsertHead/PopHead and Append/PopTail of the marked LockFreeBiList.
+
+enum class End { kFront, kBack, kBoth };
+
+const char* endName(End end) {
+    return end == End::kFront ? " front" : end == End::kBack ? " back" : " both ends";
+}
+
+bool atFront(End end, int index) {
+    return end == End::kFront || (end == End::kBoth && index % 2 == 0);
+}
+
+template<typename OPS>
+void runDequeBench(const std::string& name, End end, int listSize) {
+    for (int threads : BenchThreadCounts()) {
+        OPS ops;
+        for (int i = 0; i < listSize; i++)
+            ops.PushBack(i);
+        RunBench(name + endName(end), threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t count = 0;
+            bool front = atFront(end, index);
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (front) {
+                    ops.PushFront(index);
+                    ops.PopFront();
+                } else {
+                    ops.PushBack(index);
+                    ops.PopBack();
+                }
+                count += 2;
+            }
+            return count;
+        });
+    }
+}
+
+struct DequeOps {
+    using NodeType = LockFreeDeque<uint64_t>::NodeType;
+    LockFreeDeque<uint64_t> deque;
+
+    void PushFront(uint64_t value) { deque.PushFront(make_shared<NodeType>(value)); }
+    void PushBack(uint64_t value) { deque.PushBack(make_shared<NodeType>(value)); }
+    void PopFront() { deque.PopFront(); }
+    void PopBack() { deque.PopBack(); }
+};
+
+struct MarkedListOps {
+    using NodeType = LockFreeMarkedBiNode<uint64_t>;
+    LockFreeBiList<uint64_t, SharedPtrReclaim, LockFreeMarkedBiNode> list;
+
+    void PushFront(uint64_t value) { list.InsertHead(make_shared<NodeType>(value)); }
+    void PushBack(uint64_t value) { list.Append(make_shared<NodeType>(value)); }
+    void PopFront() { list.PopHead(); }
+    void PopBack() { list.PopTail(); }
+};
+
+int main() {
+    const int listSize = 1000;
+    for (End end : {End::kFront, End::kBack, End::kBoth}) {
+        runDequeBench<DequeOps>("deque", end, listSize);
+        runDequeBench<MarkedListOps>("bilist marked", end, listSize);
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "bench_util.h"
+
+#include <mutex>
+#include <random>
+#include <unordered_map>
+
+#include "lockfree_hash_map.h"
+#ifdef LOCKFREE_BENCH_TBB
+#include <tbb/concurrent_hash_map.h>
+#endif
+
+// Session lookup pattern: lookupPercent of the operations are finds, the rest alternate insert and erase,
+// keys are drawn from [0, keyRange). Baselines are a mutex-protected std::unordered_map and, when TBB is found,
+// tbb::concurrent_hash_map.
+
+template<typename MAP_OPS>
+void runMapBench(const std::string& name, int keyRange, int lookupPercent, MAP_OPS& ops) {
+    std::string title = name + " keys=" + std::to_string(keyRange) + " finds=" + std::to_string(lookupPercent) + "%";
+    for (int threads : BenchThreadCounts()) {
+        ops.Reset(keyRange);
+        RunBench(title, threads, [&](int index, const std::atomic<bool>& stop) {
+            std::minstd_rand linearRand(index + 1);
+            std::uniform_int_distribution<int> keys(0, keyRange - 1);
+            std::uniform_int_distribution<int> percent(0, 99);
+            uint64_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                int key = keys(linearRand);
+                if (percent(linearRand) < lookupPercent)
+                    ops.Find(key);
+                else if (count % 2 == 0)
+                    ops.Insert(key);
+                else
+                    ops.Erase(key);
+                count++;
+            }
+            return count;
+        });
+    }
+}
+
+struct LockFreeHashMapOps {
+    std::unique_ptr<LockFreeHashMap<int, int>> map;
+
+    void Reset(int keyRange) {
+        map.reset(new LockFreeHashMap<int, int>());
+        for (int key = 0; key < keyRange; key += 2)
+            map->Insert(key, key);
+    }
+
+    bool Find(int key) { return map->Find(key) != nullptr; }
+    void Insert(int key) { map->Insert(key, key); }
+    void Erase(int key) { map->Erase(key); }
+};
+
+struct MutexMapOps {
+    std::mutex mutex;
+    std::unordered_map<int, int> map;
+
+    void Reset(int keyRange) {
+        map.clear();
+        for (int key = 0; key < keyRange; key += 2)
+            map.emplace(key, key);
+    }
+
+    bool Find(int key) { std::lock_guard<std::mutex> lock(mutex); return map.find(key) != map.end(); }
+    void Insert(int key) { std::lock_guard<std::mutex> lock(mutex); map.emplace(key, key); }
+    void Erase(int key) { std::lock_guard<std::mutex> lock(mutex); map.erase(key); }
+};
+
+#ifdef LOCKFREE_BENCH_TBB
+struct TbbMapOps {
+    using MapType = tbb::concurrent_hash_map<int, int>;
+    MapType map;
+
+    void Reset(int keyRange) {
+        map.clear();
+        for (int key = 0; key < keyRange; key += 2)
+            map.insert(std::make_pair(key, key));
+    }
+
+    bool Find(int key) { MapType::const_accessor accessor; return map.find(accessor, key); }
+    void Insert(int key) { map.insert(std::make_pair(key, key)); }
+    void Erase(int key) { map.erase(key); }
+};
+#endif
+
+int main() {
+    for (int keyRange : {1000, 100000}) {
+        for (int lookupPercent : {90, 50}) {
+            LockFreeHashMapOps lockFree;
+            runMapBench("lockfree hash map", keyRange, lookupPercent, lockFree);
+            MutexMapOps mutexMap;
+            runMapBench("mutex unordered_map", keyRange, lookupPercent, mutexMap);
+#ifdef LOCKFREE_BENCH_TBB
+            TbbMapOps tbbMap;
+            runMapBench("tbb concurrent_hash_map", keyRange, lookupPercent, tbbMap);
+#endif
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "bench_util.h"
+
+#include <algorithm>
+#include <random>
+
+#include "lockfree_silist.h"
+#include "lockfree_bilist.h"
+#include "epoch_reclaim.h"
+
+// Sums a list with the manual GetNext loop and with the iterators. The nodes are linked in a shuffled order of
+// their allocation, so the walk jumps around the heap and the prefetch of the next node is what is measured.
+
+template<typename LIST, typename NODE, typename MAKE>
+void fillShuffled(LIST& list, int listSize, MAKE make) {
+    std::vector<typename LIST::NodePtr> nodes;
+    for (int i = 0; i < listSize; i++)
+        nodes.push_back(make(i));
+    std::shuffle(nodes.begin(), nodes.end(), std::minstd_rand(1));
+    for (auto& node : nodes)
+        list.Append(node);
+}
+
+template<typename LIST>
+uint64_t sumGetNext(LIST& list) {
+    typename LIST::Guard guard;
+    uint64_t sum = 0;
+    for (auto node = list.Head(); node != nullptr; node = list.GetNext(node))
+        sum += node->data_;
+    return sum;
+}
+
+template<typename LIST>
+uint64_t sumRangeFor(LIST& list) {
+    typename LIST::Guard guard;
+    uint64_t sum = 0;
+    for (auto& node : list)
+        sum += node.data_;
+    return sum;
+}
+
+template<typename LIST>
+uint64_t sumReverse(LIST& list) {
+    typename LIST::Guard guard;
+    uint64_t sum = 0;
+    for (auto it = list.rbegin(); it != list.rend(); ++it)
+        sum += it->data_;
+    return sum;
+}
+
+template<typename LIST>
+void runScan(const std::string& name, LIST& list, int listSize, uint64_t (*scan)(LIST&)) {
+    volatile uint64_t sink = 0;
+    RunBench(name, 1, [&](int, const std::atomic<bool>& stop) {
+        uint64_t ops = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            sink = sink + scan(list);
+            ops += listSize;
+        }
+        return ops;
+    });
+}
+
+template<typename LIST, typename NODE, typename MAKE>
+void runIteratorBench(const std::string& name, int listSize, MAKE make) {
+    LIST list;
+    fillShuffled<LIST, NODE>(list, listSize, make);
+    std::string title = name + " size=" + std::to_string(listSize);
+    runScan<LIST>(title + " GetNext loop", list, listSize, &sumGetNext<LIST>);
+    runScan<LIST>(title + " range-for", list, listSize, &sumRangeFor<LIST>);
+}
+
+template<typename LIST, typename NODE, typename MAKE>
+void runReverseBench(const std::string& name, int listSize, MAKE make) {
+    runIteratorBench<LIST, NODE>(name, listSize, make);
+    LIST list;
+    fillShuffled<LIST, NODE>(list, listSize, make);
+    runScan<LIST>(name + " size=" + std::to_string(listSize) + " reverse_iterator", list, listSize, &sumReverse<LIST>);
+}
+
+int main() {
+    using EpochNode = LockFreeNode<uint64_t, EpochReclaim>;
+    using EpochBiNode = LockFreeBiNode<uint64_t, EpochReclaim>;
+    for (int listSize : {1000, 100000}) {
+        runIteratorBench<LockFreeSiList<uint64_t>, LockFreeNode<uint64_t>>(
+            "silist shared_ptr", listSize, [](int i) { return make_shared<LockFreeNode<uint64_t>>(i); });
+        runReverseBench<LockFreeBiList<uint64_t>, LockFreeBiNode<uint64_t>>(
+            "bilist shared_ptr", listSize, [](int i) { return make_shared<LockFreeBiNode<uint64_t>>(i); });
+        runIteratorBench<LockFreeSiList<uint64_t, EpochReclaim>, EpochNode>(
+            "silist epoch", listSize, [](int i) { return EpochPtr<EpochNode>(new EpochNode(i)); });
+        runReverseBench<LockFreeBiList<uint64_t, EpochReclaim>, EpochBiNode>(
+            "bilist epoch", listSize, [](int i) { return EpochPtr<EpochBiNode>(new EpochBiNode(i)); });
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "bench_util.h"
+
+#include <algorithm>
+
+#include "epoch_reclaim.h"
+#include "lockfree_bilist.h"
+#include "lockfree_layout.h"
+#include "lockfree_silist.h"
+
+// Even threads insert and pop at the head while odd threads append and pop at the tail, with the control words
+// packed, padded to their own cache lines, and padded with cache aligned nodes.
+// The sentinel based deletion allows one remover per end with raw pointer reclamation (see README), so its lists
+// run one thread per end, the marked lists run the thread sweep.
+
+template<typename LIST, typename NODE, typename RECLAIM>
+void runEndsBench(const std::string& name, int threads, int listSize) {
+    LIST list;
+    for (int i = 0; i < listSize; i++)
+        list.Append(RECLAIM::template Make<NODE>(i));
+    RunBench(name + " head-side/tail-side", threads, [&](int index, const std::atomic<bool>& stop) {
+        uint64_t ops = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (index % 2 == 0) {
+                list.InsertHead(RECLAIM::template Make<NODE>(index));
+                list.PopHead();
+            } else {
+                list.Append(RECLAIM::template Make<NODE>(index));
+                list.PopTail();
+            }
+            ops += 2;
+        }
+        return ops;
+    });
+}
+
+int main() {
+    using AlignedReclaim = CacheAlignedReclaim<EpochReclaim>;
+    const int listSize = 1000;
+    runEndsBench<LockFreeBiList<uint64_t, EpochReclaim>, LockFreeBiNode<uint64_t, EpochReclaim>, EpochReclaim>(
+        "bilist epoch compact", 2, listSize);
+    runEndsBench<LockFreeBiList<uint64_t, EpochReclaim, LockFreeBiNode, ExactCounter, PaddedLayout>,
+                 LockFreeBiNode<uint64_t, EpochReclaim>, EpochReclaim>("bilist epoch padded", 2, listSize);
+    runEndsBench<LockFreeBiList<uint64_t, AlignedReclaim, LockFreeBiNode, ExactCounter, PaddedLayout>,
+                 LockFreeBiNode<uint64_t, AlignedReclaim>, AlignedReclaim>("bilist epoch padded aligned nodes", 2,
+                                                                           listSize);
+
+    int lastThreads = 0;
+    for (int threads : BenchThreadCounts()) {
+        threads = std::max(threads, 2);
+        if (threads == lastThreads)
+            continue;
+        lastThreads = threads;
+        runEndsBench<LockFreeBiList<uint64_t, SharedPtrReclaim, LockFreeMarkedBiNode>,
+                     LockFreeMarkedBiNode<uint64_t>, SharedPtrReclaim>("bilist marked compact", threads, listSize);
+        runEndsBench<LockFreeBiList<uint64_t, SharedPtrReclaim, LockFreeMarkedBiNode, ExactCounter, PaddedLayout>,
+                     LockFreeMarkedBiNode<uint64_t>, SharedPtrReclaim>("bilist marked padded", threads, listSize);
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include "bench_util.h"
+
+#include <list>
+#include <mutex>
+#include <vector>
+
+#include "lockfree_bilist.h"
+#include "lockfree_silist.h"
+#ifdef LOCKFREE_BENCH_TBB
+#include <tbb/concurrent_queue.h>
+#endif
+
+// The single-node operations of the lists, swept over BenchThreadCounts() and BenchListSizes(): every thread repeats
+// an insertion and a removal so the size stays put (InsertHead/PopHead, Append/PopTail, Append/PopHead, Insert
+// before a node of the middle and Remove of the inserted node), or walks the whole list (ops are nodes visited).
+// The baselines are std::list behind a std::mutex and, when TBB is found, tbb::concurrent_queue push/try_pop against
+// Append/PopHead. The sentinel based deletion allows one remover per end (see README), so the default lists pop
+// with one thread and the marked lists run the sweep.
+
+template<typename OPS, typename BODY>
+void runOpsBench(const std::string& name, int listSize, bool severalThreads, BODY body) {
+    for (int threads : BenchThreadCounts()) {
+        if (threads > 1 && !severalThreads)
+            break;
+        OPS ops(listSize);
+        RunBench(name + " size=" + std::to_string(listSize), threads,
+                 [&](int index, const std::atomic<bool>& stop) {
+            uint64_t count = 0;
+            while (!stop.load(std::memory_order_relaxed))
+                count += body(ops, index);
+            return count;
+        });
+    }
+}
+
+template<typename OPS>
+void runListOpsBench(const std::string& name, int listSize, bool severalRemovers) {
+    runOpsBench<OPS>(name + " insert head/pop head", listSize, severalRemovers, [](OPS& ops, int index) {
+        ops.PushFront(index);
+        ops.PopFront();
+        return 2;
+    });
+    runOpsBench<OPS>(name + " append/pop tail", listSize, severalRemovers, [](OPS& ops, int index) {
+        ops.PushBack(index);
+        ops.PopBack();
+        return 2;
+    });
+    runOpsBench<OPS>(name + " append/pop head", listSize, severalRemovers, [](OPS& ops, int index) {
+        ops.PushBack(index);
+        ops.PopFront();
+        return 2;
+    });
+    runOpsBench<OPS>(name + " insert middle/remove", listSize, true, [](OPS& ops, int index) {
+        ops.Remove(ops.InsertMiddle(index));
+        return 2;
+    });
+    runOpsBench<OPS>(name + " traverse", listSize, true, [](OPS& ops, int) {
+        return ops.Traverse();
+    });
+}
+
+template<typename LIST>
+struct LockFreeListOps {
+    using NodeType = typename LIST::NodeType;
+    using NodePtr = typename LIST::NodePtr;
+
+    LIST list;
+    // nodes of the middle, every thread inserts before its own one, no workload using them removes them
+    std::vector<NodePtr> anchors;
+
+    explicit LockFreeListOps(int listSize) {
+        for (int i = 0; i < listSize; i++) {
+            NodePtr node = make_shared<NodeType>(i);
+            list.Append(node);
+            if (i >= listSize / 4 && i < listSize * 3 / 4)
+                anchors.push_back(node);
+        }
+    }
+
+    void PushFront(uint64_t value) { list.InsertHead(make_shared<NodeType>(value)); }
+    void PushBack(uint64_t value) { list.Append(make_shared<NodeType>(value)); }
+    void PopFront() { list.PopHead(); }
+    void PopBack() { list.PopTail(); }
+
+    NodePtr InsertMiddle(int index) {
+        NodePtr node = make_shared<NodeType>(index);
+        list.Insert(node, anchors[index % anchors.size()]);
+        return node;
+    }
+
+    void Remove(const NodePtr& node) { list.Remove(node); }
+
+    uint64_t Traverse() {
+        typename LIST::Guard guard;
+        uint64_t visited = 0;
+        for (NodePtr node = list.Head(); node != nullptr; node = list.GetNext(node))
+            visited++;
+        return visited;
+    }
+};
+
+struct MutexListOps {
+    using Iterator = std::list<uint64_t>::iterator;
+
+    std::mutex mutex;
+    std::list<uint64_t> list;
+    std::vector<Iterator> anchors;
+
+    explicit MutexListOps(int listSize) {
+        for (int i = 0; i < listSize; i++) {
+            Iterator it = list.insert(list.end(), i);
+            if (i >= listSize / 4 && i < listSize * 3 / 4)
+                anchors.push_back(it);
+        }
+    }
+
+    void PushFront(uint64_t value) { std::lock_guard<std::mutex> lock(mutex); list.push_front(value); }
+    void PushBack(uint64_t value) { std::lock_guard<std::mutex> lock(mutex); list.push_back(value); }
+
+    void PopFront() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!list.empty())
+            list.pop_front();
+    }
+
+    void PopBack() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!list.empty())
+            list.pop_back();
+    }
+
+    Iterator InsertMiddle(int index) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return list.insert(anchors[index % anchors.size()], index);
+    }
+
+    void Remove(Iterator it) { std::lock_guard<std::mutex> lock(mutex); list.erase(it); }
+
+    uint64_t Traverse() {
+        std::lock_guard<std::mutex> lock(mutex);
+        uint64_t visited = 0;
+        for (auto it = list.begin(); it != list.end(); ++it)
+            visited++;
+        return visited;
+    }
+};
+
+#ifdef LOCKFREE_BENCH_TBB
+struct TbbQueueOps {
+    tbb::concurrent_queue<uint64_t> queue;
+
+    explicit TbbQueueOps(int listSize) {
+        for (int i = 0; i < listSize; i++)
+            queue.push(i);
+    }
+};
+#endif
+
+int main() {
+    using MarkedSiList = LockFreeSiList<uint64_t, SharedPtrReclaim, LockFreeMarkedNode>;
+    using MarkedBiList = LockFreeBiList<uint64_t, SharedPtrReclaim, LockFreeMarkedBiNode>;
+    for (int listSize : BenchListSizes()) {
+        runListOpsBench<LockFreeListOps<LockFreeSiList<uint64_t>>>("silist", listSize, false);
+        runListOpsBench<LockFreeListOps<LockFreeBiList<uint64_t>>>("bilist", listSize, false);
+        runListOpsBench<LockFreeListOps<MarkedSiList>>("silist marked", listSize, true);
+        runListOpsBench<LockFreeListOps<MarkedBiList>>("bilist marked", listSize, true);
+        runListOpsBench<MutexListOps>("mutex std::list", listSize, true);
+#ifdef LOCKFREE_BENCH_TBB
+        runOpsBench<TbbQueueOps>("tbb concurrent_queue push/try_pop", listSize, true, [](TbbQueueOps& ops, int index) {
+            uint64_t value = index;
+            ops.queue.push(value);
+            ops.queue.try_pop(value);
+            return 2;
+        });
+#endif
+    }
+    return 0;
+}
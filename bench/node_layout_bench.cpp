@@ -0,0 +1,103 @@
+#include "bench_util.h"
+
+#include "epoch_reclaim.h"
+#include "lockfree_bilist.h"
+#include "lockfree_silist.h"
+
+// Compares the node layout before and after the linking hooks were resolved at compile time: prints the size of the
+// node types, then runs the hot paths of the list on epoch reclaimed raw pointer nodes, where the cost of the layout
+// is not hidden behind shared_ptr reference counting. The nodes before carry a vtable pointer in front of their links,
+// as the virtual destructor of the old nodes did. The virtual linking hooks of the old lists are not emulated, their
+// dispatch came on top of the before column.
+
+template<typename T, typename RECLAIM>
+struct VtableNode : LockFreeHook<VtableNode<T, RECLAIM>, RECLAIM> {
+    T data_;
+
+    VtableNode(T data) : data_(data) {}
+
+    virtual ~VtableNode() {}
+};
+
+template<typename T, typename RECLAIM>
+struct VtableBiNode : LockFreeBiHook<VtableBiNode<T, RECLAIM>, RECLAIM> {
+    T data_;
+
+    VtableBiNode(T data) : data_(data) {}
+
+    virtual ~VtableBiNode() {}
+};
+
+template<typename BEFORE, typename AFTER>
+void printNodeSize(const char* name) {
+    printf("%-56s sizeof before=%3zu  after=%3zu\n", name, sizeof(BEFORE), sizeof(AFTER));
+}
+
+template<typename LIST, typename NODE>
+std::vector<BenchResult> runLayoutBench(const std::string& name, int listSize) {
+    std::vector<BenchResult> results;
+    for (int threads : BenchThreadCounts()) {
+        LIST list;
+        for (int i = 0; i < listSize; i++)
+            list.Append(EpochPtr<NODE>(new NODE(i)));
+        results.push_back(RunBench(name + " append/pop head", threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                list.Append(EpochPtr<NODE>(new NODE(index)));
+                list.PopHead();
+                ops += 2;
+            }
+            return ops;
+        }));
+    }
+
+    LIST list;
+    for (int i = 0; i < listSize; i++)
+        list.Append(EpochPtr<NODE>(new NODE(i)));
+    results.push_back(RunBench(name + " size=" + std::to_string(listSize) + " traverse", 1,
+                               [&](int, const std::atomic<bool>& stop) {
+        uint64_t visited = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            typename LIST::Guard guard;
+            for (auto node = list.Head(); node != nullptr; node = list.GetNext(node))
+                visited++;
+        }
+        return visited;
+    }));
+    return results;
+}
+
+void printComparison(const std::vector<BenchResult>& before, const std::vector<BenchResult>& after) {
+    for (size_t i = 0; i < before.size() && i < after.size(); i++) {
+        printf("%-56s threads=%3d  ops/s before=%12.0f  after=%12.0f  x%.2f\n",
+               after[i].name.c_str(), after[i].threads,
+               before[i].OpsPerSecond(), after[i].OpsPerSecond(),
+               before[i].OpsPerSecond() > 0 ? after[i].OpsPerSecond() / before[i].OpsPerSecond() : 0);
+    }
+}
+
+int main() {
+    printNodeSize<VtableNode<uint64_t, SharedPtrReclaim>, LockFreeNode<uint64_t>>("LockFreeNode<uint64_t> shared_ptr");
+    printNodeSize<VtableBiNode<uint64_t, SharedPtrReclaim>, LockFreeBiNode<uint64_t>>(
+        "LockFreeBiNode<uint64_t> shared_ptr");
+    printNodeSize<VtableNode<uint64_t, EpochReclaim>, LockFreeNode<uint64_t, EpochReclaim>>(
+        "LockFreeNode<uint64_t> epoch");
+    printNodeSize<VtableBiNode<uint64_t, EpochReclaim>, LockFreeBiNode<uint64_t, EpochReclaim>>(
+        "LockFreeBiNode<uint64_t> epoch");
+    printf("%-56s sizeof=%3zu\n", "LockFreeMarkedNode<uint64_t>", sizeof(LockFreeMarkedNode<uint64_t>));
+    printf("%-56s sizeof=%3zu\n", "LockFreeMarkedBiNode<uint64_t>", sizeof(LockFreeMarkedBiNode<uint64_t>));
+
+    const int listSize = 1000;
+    auto siBefore = runLayoutBench<LockFreeSiList<uint64_t, EpochReclaim, VtableNode>,
+                                   VtableNode<uint64_t, EpochReclaim>>("silist epoch vtable node", listSize);
+    auto siAfter = runLayoutBench<LockFreeSiList<uint64_t, EpochReclaim>, LockFreeNode<uint64_t, EpochReclaim>>(
+        "silist epoch", listSize);
+    auto biBefore = runLayoutBench<LockFreeBiList<uint64_t, EpochReclaim, VtableBiNode>,
+                                   VtableBiNode<uint64_t, EpochReclaim>>("bilist epoch vtable node", listSize);
+    auto biAfter = runLayoutBench<LockFreeBiList<uint64_t, EpochReclaim>, LockFreeBiNode<uint64_t, EpochReclaim>>(
+        "bilist epoch", listSize);
+
+    printComparison(siBefore, siAfter);
+    printComparison(biBefore, biAfter);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "bench_util.h"
+
+#include <new>
+
+#include "lockfree_silist.h"
+#include "epoch_reclaim.h"
+#include "lockfree_pool.h"
+
+// Every thread appends a new node and pops the head, so each operation pair creates and frees one node.
+// Heap allocations are counted by replacing the global operator new of this program.
+
+static std::atomic<uint64_t> heapAllocations(0);
+
+void* operator new(size_t size) {
+    heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* address = std::malloc(size);
+    if (address == nullptr)
+        throw std::bad_alloc();
+    return address;
+}
+
+void operator delete(void* address) noexcept {
+    std::free(address);
+}
+
+void operator delete(void* address, size_t) noexcept {
+    std::free(address);
+}
+
+template<typename RECLAIM, typename MAKE>
+void runPoolBench(const std::string& name, MAKE make) {
+    using ListType = LockFreeSiList<uint64_t, RECLAIM>;
+    for (int threads : BenchThreadCounts()) {
+        ListType list;
+        uint64_t allocationsBefore = heapAllocations.load();
+        BenchResult result = RunBench(name + " append/pop", threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                typename RECLAIM::Guard guard;
+                list.Append(make(index));
+                list.PopHead();
+                ops += 2;
+            }
+            return ops;
+        });
+        printf("%-56s threads=%3d  heap allocations/op=%6.3f\n", (name + " append/pop").c_str(), threads,
+               double(heapAllocations.load() - allocationsBefore) / result.ops);
+    }
+}
+
+int main() {
+    using EpochNode = LockFreeNode<uint64_t, EpochReclaim>;
+    using PooledShared = PooledReclaim<SharedPtrReclaim>;
+    using PooledEpoch = PooledReclaim<EpochReclaim>;
+    using PooledHugeEpoch = PooledReclaim<EpochReclaim, true>;
+
+    runPoolBench<SharedPtrReclaim>("make_shared", [](uint64_t i) {
+        return make_shared<LockFreeNode<uint64_t>>(i);
+    });
+    runPoolBench<PooledShared>("pooled shared_ptr", [](uint64_t i) {
+        return PooledShared::Make<LockFreeNode<uint64_t, PooledShared>>(i);
+    });
+    runPoolBench<EpochReclaim>("epoch new", [](uint64_t i) {
+        return EpochPtr<EpochNode>(new EpochNode(i));
+    });
+    runPoolBench<PooledEpoch>("pooled epoch", [](uint64_t i) {
+        return PooledEpoch::Make<LockFreeNode<uint64_t, PooledEpoch>>(i);
+    });
+    runPoolBench<PooledHugeEpoch>("pooled epoch huge pages", [](uint64_t i) {
+        return PooledHugeEpoch::Make<LockFreeNode<uint64_t, PooledHugeEpoch>>(i);
+    });
+    return 0;
+}
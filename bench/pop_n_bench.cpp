@@ -0,0 +1,83 @@
+#include "bench_util.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "epoch_reclaim.h"
+#include "lockfree_bilist.h"
+#include "lockfree_silist.h"
+
+// One consumer drains the list with PopHead, with PopHeadN at batch sizes 1, 16 and 256 or with DrainAll,
+// while the other threads append batches of 256 with AppendChain. Counts the consumed items.
+// The producers pause above kBacklog items, so the consumer is never starved nor the list unbounded.
+
+const int64_t kBacklog = 1 << 16;
+const int kProducerBatch = 256;
+
+template<typename LIST, typename MAKE, typename CONSUME>
+void runPopNBench(const std::string& name, MAKE make, CONSUME consume) {
+    int lastThreads = 0;
+    for (int threads : BenchThreadCounts()) {
+        threads = std::max(threads, 2);
+        if (threads == lastThreads)
+            continue;
+        lastThreads = threads;
+        LIST list;
+        RunBench(name, threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t items = 0;
+            if (index == 0) {
+                std::vector<typename LIST::NodePtr> nodes;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    typename LIST::Guard guard;
+                    items += consume(list, nodes);
+                    nodes.clear();
+                }
+                return items;
+            }
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (list.Size() > kBacklog) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                typename LIST::NodePtr first = make(index);
+                typename LIST::NodePtr last = first;
+                for (int i = 1; i < kProducerBatch; i++) {
+                    typename LIST::NodePtr node = make(index);
+                    last->SetNext(node);
+                    last = node;
+                }
+                list.AppendChain(first, last, kProducerBatch);
+            }
+            return items;
+        });
+    }
+}
+
+template<typename LIST, typename MAKE>
+void runPopNBenches(const std::string& name, MAKE make) {
+    using NodePtr = typename LIST::NodePtr;
+    runPopNBench<LIST>(name + " PopHead", make, [](LIST& list, std::vector<NodePtr>&) {
+        return uint64_t(list.PopHead() != nullptr ? 1 : 0);
+    });
+    for (size_t batch : {1, 16, 256}) {
+        runPopNBench<LIST>(name + " PopHeadN batch=" + std::to_string(batch), make,
+                                 [batch](LIST& list, std::vector<NodePtr>& nodes) {
+            return uint64_t(list.PopHeadN(batch, nodes));
+        });
+    }
+    runPopNBench<LIST>(name + " DrainAll", make, [](LIST& list, std::vector<NodePtr>&) {
+        return uint64_t(list.DrainAll().size());
+    });
+}
+
+int main() {
+    using EpochNode = LockFreeNode<uint64_t, EpochReclaim>;
+    runPopNBenches<LockFreeSiList<uint64_t, EpochReclaim>>("silist epoch", [](uint64_t i) {
+        return EpochPtr<EpochNode>(new EpochNode(i));
+    });
+    using MarkedNode = LockFreeMarkedBiNode<uint64_t>;
+    runPopNBenches<LockFreeBiList<uint64_t, SharedPtrReclaim, LockFreeMarkedBiNode>>("bilist marked", [](uint64_t i) {
+        return make_shared<MarkedNode>(i);
+    });
+    return 0;
+}
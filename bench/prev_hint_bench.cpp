@@ -0,0 +1,46 @@
+#include "bench_util.h"
+
+#include <random>
+
+#include "lockfree_silist.h"
+
+// Removes a random middle node of a singly linked list and inserts it back, with and without predecessor hints.
+
+template<typename LIST, typename NODE>
+void runPrevHintBench(const std::string& name, int listSize) {
+    for (bool hinted : {false, true}) {
+        LIST list;
+        std::vector<shared_ptr<NODE>> nodes;
+        for (int i = 0; i < listSize; i++) {
+            nodes.push_back(make_shared<NODE>(i));
+            list.Append(nodes.back());
+        }
+        std::string title = name + " size=" + std::to_string(listSize) + (hinted ? " remove/insert hinted" : " remove/insert");
+        RunBench(title, 1, [&](int, const std::atomic<bool>& stop) {
+            std::minstd_rand linearRand(1);
+            std::uniform_int_distribution<int> distrib(1, listSize - 2);
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                int index = distrib(linearRand);
+                if (hinted) {
+                    list.Remove(nodes[index], nodes[index - 1]);
+                    list.Insert(nodes[index], nodes[index + 1], nodes[index - 1]);
+                } else {
+                    list.Remove(nodes[index]);
+                    list.Insert(nodes[index], nodes[index + 1]);
+                }
+                ops += 2;
+            }
+            return ops;
+        });
+    }
+}
+
+int main() {
+    for (int listSize : {1000, 100000}) {
+        runPrevHintBench<LockFreeSiList<uint64_t>, LockFreeNode<uint64_t>>("silist", listSize);
+        runPrevHintBench<LockFreeSiList<uint64_t, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<uint64_t>>(
+            "silist marked", listSize);
+    }
+    return 0;
+}
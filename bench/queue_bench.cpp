@@ -0,0 +1,87 @@
+#include "bench_util.h"
+
+#include <memory>
+
+#include "epoch_reclaim.h"
+#include "lockfree_queue.h"
+#include "lockfree_silist.h"
+#ifdef LOCKFREE_BENCH_TBB
+#include <tbb/concurrent_queue.h>
+#endif
+
+// Producer/consumer pairs: for every thread count n of the sweep, n threads enqueue and n threads dequeue, counts the
+// items enqueued plus the items dequeued. Compares LockFreeQueue with Append/PopHead of a marked LockFreeSiList (the
+// list deletion scheme which allows several consumers) and, when TBB is found, tbb::concurrent_queue.
+// The producers pause above kBacklog items, so the consumers are never starved nor the queue unbounded.
+
+const int64_t kBacklog = 1 << 16;
+
+template<typename QUEUE_OPS>
+void runQueueBench(const std::string& name) {
+    for (int pairs : BenchThreadCounts()) {
+        QUEUE_OPS ops;
+        RunBench(name + " producers=consumers=" + std::to_string(pairs), 2 * pairs,
+                 [&](int index, const std::atomic<bool>& stop) {
+            uint64_t items = 0;
+            uint64_t value = index;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (index % 2 == 1) {
+                    items += ops.TryDequeue(value);
+                } else if (ops.Size() < kBacklog) {
+                    ops.Enqueue(value);
+                    items++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            return items;
+        });
+    }
+}
+
+template<typename RECLAIM, typename LAYOUT = CompactLayout>
+struct LockFreeQueueOps {
+    LockFreeQueue<uint64_t, RECLAIM, ExactCounter, LAYOUT> queue;
+
+    void Enqueue(uint64_t value) { queue.Enqueue(value); }
+    bool TryDequeue(uint64_t& value) { return queue.TryDequeue(value); }
+    int64_t Size() { return queue.Size(); }
+};
+
+struct MarkedListOps {
+    using NodeType = LockFreeMarkedNode<uint64_t>;
+    LockFreeSiList<uint64_t, SharedPtrReclaim, LockFreeMarkedNode> list;
+
+    void Enqueue(uint64_t value) { list.Append(make_shared<NodeType>(value)); }
+
+    bool TryDequeue(uint64_t& value) {
+        shared_ptr<NodeType> node = list.PopHead();
+        if (node == nullptr)
+            return false;
+        value = node->data_;
+        return true;
+    }
+
+    int64_t Size() { return list.Size(); }
+};
+
+#ifdef LOCKFREE_BENCH_TBB
+struct TbbQueueOps {
+    tbb::concurrent_queue<uint64_t> queue;
+
+    void Enqueue(uint64_t value) { queue.push(value); }
+    bool TryDequeue(uint64_t& value) { return queue.try_pop(value); }
+    int64_t Size() { return queue.unsafe_size(); }
+};
+#endif
+
+int main() {
+    runQueueBench<LockFreeQueueOps<SharedPtrReclaim>>("queue shared_ptr");
+    runQueueBench<LockFreeQueueOps<EpochReclaim>>("queue epoch");
+    runQueueBench<LockFreeQueueOps<EpochReclaim, PaddedLayout>>("queue epoch padded");
+    runQueueBench<MarkedListOps>("silist marked append/pop head");
+#ifdef LOCKFREE_BENCH_TBB
+    runQueueBench<TbbQueueOps>("tbb concurrent_queue");
+#endif
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "bench_util.h"
+
+#include "epoch_reclaim.h"
+#include "hazard_pointer.h"
+#include "lockfree_bilist.h"
+#include "lockfree_silist.h"
+
+// Compares the shared_ptr linked nodes with the hazard pointer and epoch based reclamation policies.
+// A traversal holds one LIST::Guard, so the epoch policy pins once per pass over the list.
+
+template<typename NODE>
+shared_ptr<NODE> newNode(SharedPtrReclaim, uint64_t value) {
+    return make_shared<NODE>(value);
+}
+
+template<typename NODE>
+HazardPtr<NODE> newNode(HazardPointerReclaim, uint64_t value) {
+    return HazardPtr<NODE>(new NODE(value));
+}
+
+template<typename NODE>
+EpochPtr<NODE> newNode(EpochReclaim, uint64_t value) {
+    return EpochPtr<NODE>(new NODE(value));
+}
+
+template<typename LIST, typename NODE, typename RECLAIM>
+void runReclaimBench(const std::string& name, int listSize) {
+    for (int threads : BenchThreadCounts()) {
+        LIST list;
+        for (int i = 0; i < listSize; i++)
+            list.Append(newNode<NODE>(RECLAIM(), i));
+        RunBench(name + " traverse", threads, [&](int, const std::atomic<bool>& stop) {
+            uint64_t visited = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                typename LIST::Guard guard;
+                for (auto node = list.Head(); node != nullptr; node = list.GetNext(node))
+                    visited++;
+            }
+            return visited;
+        });
+    }
+
+    // one mutator appends and pops while the other threads keep traversing
+    for (int threads : BenchThreadCounts()) {
+        LIST list;
+        for (int i = 0; i < listSize; i++)
+            list.Append(newNode<NODE>(RECLAIM(), i));
+        RunBench(name + " traverse with append/pop head", threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (index == 0) {
+                    list.Append(newNode<NODE>(RECLAIM(), index));
+                    list.PopHead();
+                    ops += 2;
+                } else {
+                    typename LIST::Guard guard;
+                    for (auto node = list.Head(); node != nullptr; node = list.GetNext(node))
+                        ops++;
+                }
+            }
+            return ops;
+        });
+    }
+}
+
+int main() {
+    const int listSize = 1000;
+    runReclaimBench<LockFreeSiList<uint64_t>, LockFreeNode<uint64_t>, SharedPtrReclaim>(
+        "silist shared_ptr", listSize);
+    runReclaimBench<LockFreeSiList<uint64_t, HazardPointerReclaim>, LockFreeNode<uint64_t, HazardPointerReclaim>,
+                    HazardPointerReclaim>("silist hazard pointer", listSize);
+    runReclaimBench<LockFreeSiList<uint64_t, EpochReclaim>, LockFreeNode<uint64_t, EpochReclaim>,
+                    EpochReclaim>("silist epoch", listSize);
+    runReclaimBench<LockFreeBiList<uint64_t>, LockFreeBiNode<uint64_t>, SharedPtrReclaim>(
+        "bilist shared_ptr", listSize);
+    runReclaimBench<LockFreeBiList<uint64_t, HazardPointerReclaim>, LockFreeBiNode<uint64_t, HazardPointerReclaim>,
+                    HazardPointerReclaim>("bilist hazard pointer", listSize);
+    runReclaimBench<LockFreeBiList<uint64_t, EpochReclaim>, LockFreeBiNode<uint64_t, EpochReclaim>,
+                    EpochReclaim>("bilist epoch", listSize);
+    return 0;
+}
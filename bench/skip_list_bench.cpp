@@ -0,0 +1,88 @@
+#include "bench_util.h"
+
+#include <algorithm>
+#include <random>
+
+#include "lockfree_silist.h"
+#include "lockfree_skip_list.h"
+
+// Looks up random keys in the skip list and with a linear search of a LockFreeSiList holding the same keys,
+// then runs mixed Find/Insert/Remove on the skip list over the thread sweep.
+
+struct Entry {
+    int key;
+    int value;
+};
+
+void runLookupBench(int listSize) {
+    std::vector<int> keys;
+    for (int i = 0; i < listSize; i++)
+        keys.push_back(i);
+    std::shuffle(keys.begin(), keys.end(), std::minstd_rand(1));
+
+    LockFreeSkipList<int, int> map;
+    LockFreeSiList<Entry> list;
+    for (int key : keys) {
+        map.Insert(key, key);
+        list.Append(make_shared<LockFreeNode<Entry>>(Entry{key, key}));
+    }
+
+    std::string suffix = " size=" + std::to_string(listSize) + " find";
+    RunBench("skip list" + suffix, 1, [&](int, const std::atomic<bool>& stop) {
+        std::minstd_rand linearRand(1);
+        std::uniform_int_distribution<int> distrib(0, listSize - 1);
+        uint64_t ops = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            map.Find(distrib(linearRand));
+            ops++;
+        }
+        return ops;
+    });
+    RunBench("silist linear search" + suffix, 1, [&](int, const std::atomic<bool>& stop) {
+        std::minstd_rand linearRand(1);
+        std::uniform_int_distribution<int> distrib(0, listSize - 1);
+        uint64_t ops = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            int key = distrib(linearRand);
+            for (auto node = list.Head(); node != nullptr; node = list.GetNext(node)) {
+                if (node->data_.key == key)
+                    break;
+            }
+            ops++;
+        }
+        return ops;
+    });
+}
+
+void runMixedBench(int keyRange) {
+    for (int threads : BenchThreadCounts()) {
+        LockFreeSkipList<int, int> map;
+        for (int key = 0; key < keyRange; key += 2)
+            map.Insert(key, key);
+        RunBench("skip list keys=" + std::to_string(keyRange) + " 80% find/10% insert/10% remove", threads,
+                 [&](int index, const std::atomic<bool>& stop) {
+            std::minstd_rand linearRand(index + 1);
+            std::uniform_int_distribution<int> keys(0, keyRange - 1);
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                int key = keys(linearRand);
+                int op = ops % 10;
+                if (op == 0)
+                    map.Insert(key, key);
+                else if (op == 1)
+                    map.Remove(key);
+                else
+                    map.Find(key);
+                ops++;
+            }
+            return ops;
+        });
+    }
+}
+
+int main() {
+    for (int listSize : {1000, 100000})
+        runLookupBench(listSize);
+    runMixedBench(100000);
+    return 0;
+}
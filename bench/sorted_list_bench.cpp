@@ -0,0 +1,64 @@
+#include "bench_util.h"
+
+#include <mutex>
+#include <random>
+#include <set>
+
+#include "lockfree_sorted_list.h"
+
+// Mixed lookups and updates on a key range, the sorted list against a mutex-protected std::set.
+// Every thread draws keys from [0, keyRange), lookupPercent of the operations are Contains,
+// the rest alternate between inserting and removing a key.
+
+template<typename INSERT, typename REMOVE, typename CONTAINS>
+void runMixed(const std::string& name, int keyRange, int lookupPercent, INSERT insert, REMOVE remove,
+              CONTAINS contains) {
+    for (int threads : BenchThreadCounts()) {
+        RunBench(name, threads, [&](int index, const std::atomic<bool>& stop) {
+            std::minstd_rand linearRand(index + 1);
+            std::uniform_int_distribution<int> keys(0, keyRange - 1);
+            std::uniform_int_distribution<int> percent(0, 99);
+            uint64_t ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                int key = keys(linearRand);
+                if (percent(linearRand) < lookupPercent)
+                    contains(key);
+                else if (ops % 2 == 0)
+                    insert(key);
+                else
+                    remove(key);
+                ops++;
+            }
+            return ops;
+        });
+    }
+}
+
+void runSortedListBench(int keyRange, int lookupPercent) {
+    std::string suffix = " keys=" + std::to_string(keyRange) + " lookups=" + std::to_string(lookupPercent) + "%";
+
+    LockFreeSortedList<int> list;
+    for (int key = 0; key < keyRange; key += 2)
+        list.InsertSorted(make_shared<LockFreeMarkedNode<int>>(key));
+    runMixed("sorted list" + suffix, keyRange, lookupPercent,
+             [&](int key) { list.InsertSorted(make_shared<LockFreeMarkedNode<int>>(key)); },
+             [&](int key) { list.RemoveKey(key); },
+             [&](int key) { return list.Contains(key); });
+
+    std::mutex mutex;
+    std::set<int> set;
+    for (int key = 0; key < keyRange; key += 2)
+        set.insert(key);
+    runMixed("mutex std::set" + suffix, keyRange, lookupPercent,
+             [&](int key) { std::lock_guard<std::mutex> lock(mutex); set.insert(key); },
+             [&](int key) { std::lock_guard<std::mutex> lock(mutex); set.erase(key); },
+             [&](int key) { std::lock_guard<std::mutex> lock(mutex); return set.count(key) != 0; });
+}
+
+int main() {
+    for (int keyRange : {64, 1024}) {
+        runSortedListBench(keyRange, 90);
+        runSortedListBench(keyRange, 50);
+    }
+    return 0;
+}
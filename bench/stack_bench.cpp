@@ -0,0 +1,45 @@
+#include "bench_util.h"
+
+#include "lockfree_stack.h"
+
+// Every thread pushes a node and pops one, all on the same head: the elimination stack against InsertHead/PopHead
+// of the marked LockFreeSiList it is built on, e.g. BENCH_MAX_THREADS=64 for the contended end of the sweep.
+
+template<typename OPS>
+void runStackBench(const std::string& name) {
+    for (int threads : BenchThreadCounts()) {
+        OPS ops;
+        RunBench(name + " push/pop", threads, [&](int index, const std::atomic<bool>& stop) {
+            uint64_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                ops.Push(index);
+                ops.Pop();
+                count += 2;
+            }
+            return count;
+        });
+    }
+}
+
+template<size_t SLOTS>
+struct StackOps {
+    using StackType = LockFreeStack<uint64_t, SharedPtrReclaim, ExactCounter, CompactLayout, SLOTS>;
+    StackType stack;
+
+    void Push(uint64_t value) { stack.Push(make_shared<typename StackType::NodeType>(value)); }
+    void Pop() { stack.Pop(); }
+};
+
+struct MarkedListOps {
+    LockFreeSiList<uint64_t, SharedPtrReclaim, LockFreeMarkedNode> list;
+
+    void Push(uint64_t value) { list.InsertHead(make_shared<LockFreeMarkedNode<uint64_t>>(value)); }
+    void Pop() { list.PopHead(); }
+};
+
+int main() {
+    runStackBench<MarkedListOps>("silist marked insert/pop head");
+    runStackBench<StackOps<2>>("elimination stack 2 slots");
+    runStackBench<StackOps<8>>("elimination stack 8 slots");
+    return 0;
+}
@@ -1,181 +1,268 @@
-#include <cassert>
-#include <iostream>
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <mutex>
 #include <random>
-#include <set>
+#include <string>
 #include <thread>
 #include <vector>
 
 #include "include/lockfree_bilist.h"
 #include "include/lockfree_silist.h"
 
-unsigned seed;
+// Stress harness: N threads append, N threads insert at the head, 2 x N threads remove random nodes of the
+// inserting threads, all on one LockFreeSiList. Every list operation is timed into a per-thread latency histogram,
+// the histograms are merged per operation type at the end.
+//
+//   demo [--threads N] [--seconds S] [--ops N]
+//
+// --threads  threads per group, 99 by default
+// --seconds  run length, 10 by default
+// --ops      operations per inserting thread, 1000 by default, 0 for no limit; the run ends at whichever limit comes
+//            first
 
-struct NodesItem {
-  std::set<shared_ptr<LockFreeNode<uint64_t>>> nodes;
-  std::mutex mtx;
+/**
+ * HDR style histogram: values below 2^kSubBits are counted exactly, every larger power of two is split into
+ * 2^kSubBits linear sub-buckets, so a recorded value is off by at most 1/32 (about 3%).
+ * Values from 2^kMaxBits nanoseconds on (about 18 minutes) go into the last bucket.
+ */
+class LatencyHistogram {
+ public:
+  static const int kSubBits = 5;
+  static const uint64_t kSubCount = uint64_t(1) << kSubBits;
+  static const int kMaxBits = 40;
+  static const size_t kBucketCount = (kMaxBits - kSubBits + 1) * kSubCount;
 
-  NodesItem() : nodes(), mtx() {}
+  LatencyHistogram() : counts_(kBucketCount, 0), total_(0), max_(0) {}
 
-  void add_node(shared_ptr<LockFreeNode<uint64_t>> node) {
-    std::lock_guard<std::mutex> lock(mtx);
-    nodes.insert(node);
+  void record(uint64_t value) {
+    counts_[index_of(value)]++;
+    total_++;
+    max_ = std::max(max_, value);
   }
 
-  shared_ptr<LockFreeNode<uint64_t>> remove_node() {
-    std::lock_guard<std::mutex> lock(mtx);
+  void merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < kBucketCount; i++)
+      counts_[i] += other.counts_[i];
+    total_ += other.total_;
+    max_ = std::max(max_, other.max_);
+  }
 
-    if (nodes.empty()) {
-      return nullptr;
+  uint64_t total() const { return total_; }
+
+  uint64_t max() const { return max_; }
+
+  // The highest value of the bucket holding the given fraction of the recorded values
+  uint64_t percentile(double fraction) const {
+    if (total_ == 0)
+      return 0;
+    uint64_t rank = std::max<uint64_t>(1, uint64_t(fraction * total_ + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+      seen += counts_[i];
+      if (seen >= rank)
+        return std::min(lowest_of(i + 1) - 1, max_);
     }
+    return max_;
+  }
 
-    std::random_device rd;  // 获取一个随机数种子
-    std::mt19937 gen(rd());  // 使用Mersenne Twister算法创建一个随机数生成器
-    std::uniform_int_distribution<> dis(0, nodes.size() - 1);
+ private:
+  std::vector<uint64_t> counts_;
+  uint64_t total_;
+  uint64_t max_;
 
-    auto it = nodes.begin();
-    std::advance(it, dis(gen));  // 移动迭代器到随机位置
-    shared_ptr<LockFreeNode<uint64_t>> node = *it;
-    nodes.erase(it);
+  static size_t index_of(uint64_t value) {
+    if (value < kSubCount)
+      return size_t(value);
+    int magnitude = 63 - __builtin_clzll(value);
+    if (magnitude >= kMaxBits)
+      return kBucketCount - 1;
+    uint64_t sub = value >> (magnitude - kSubBits);
+    return size_t((magnitude - kSubBits + 1) * kSubCount + (sub - kSubCount));
+  }
 
-    return node;
+  static uint64_t lowest_of(size_t index) {
+    if (index < kSubCount)
+      return index;
+    uint64_t block = index / kSubCount;
+    uint64_t sub = index % kSubCount;
+    return (kSubCount + sub) << (block - 1);
   }
 };
 
-uint64_t generateRandomUint64() {
-  std::mt19937_64 generator(seed);
-  return generator();
+enum Operation { kAppend, kInsertHead, kRemove, kOperationCount };
+
+const char* operation_name(int operation) {
+  static const char* names[] = {"append", "insert head", "remove"};
+  return names[operation];
 }
 
-int main() {
-  std::cout << "hello cxx" << std::endl;
-  std::vector<std::thread> threads01;
-  std::vector<std::thread> threads02;
-  std::vector<std::thread> threads03;
-  std::vector<std::thread> threads04;
+struct ThreadStats {
+  Operation operation;
+  LatencyHistogram latency;
+  uint64_t failures = 0;
 
-  std::vector<NodesItem> nodes01(100);
-  std::vector<NodesItem> nodes02(100);
+  explicit ThreadStats(Operation operation) : operation(operation) {}
+};
 
-  seed = std::chrono::system_clock::now().time_since_epoch().count();
-  LockFreeSiList<uint64_t> list;
+struct NodesItem {
+  std::vector<shared_ptr<LockFreeNode<uint64_t>>> nodes;
+  std::mutex mtx;
 
-  for (int i = 0; i < 99; ++i) {
-    threads01.push_back(std::thread(
-        [&](int n) {
-          int count = 0;
-          while (++count < 1000) {
-            uint64_t random = generateRandomUint64();
-            shared_ptr<LockFreeNode<uint64_t>> node =
-                make_shared<LockFreeNode<uint64_t>>(random);
-            if (!list.Append(node)) {
-              std::cout << "-------------- append failed" << std::endl;
-              std::this_thread::sleep_for(std::chrono::seconds(10));
-            }
-            nodes01[n].add_node(node);
-          }
-          printf("thread[%d] append done\n", n);
-        },
-        i));
+  void add_node(shared_ptr<LockFreeNode<uint64_t>> node) {
+    std::lock_guard<std::mutex> lock(mtx);
+    nodes.push_back(std::move(node));
   }
 
-  for (int i = 0; i < 99; ++i) {
-    threads02.push_back(std::thread(
-        [&](int n) {
-          int count = 0;
-          while (++count < 1000) {
-            uint64_t random = generateRandomUint64();
-            shared_ptr<LockFreeNode<uint64_t>> node =
-                make_shared<LockFreeNode<uint64_t>>(random);
-            if (!list.InsertHead(node)) {
-              std::cout << "-------------- insert failed" << std::endl;
-              std::this_thread::sleep_for(std::chrono::seconds(10));
-            }
-            nodes02[n].add_node(node);
-          }
-          printf("thread[%d] insert head done\n", n);
-        },
-        i));
+  shared_ptr<LockFreeNode<uint64_t>> remove_node(std::mt19937_64& generator) {
+    std::lock_guard<std::mutex> lock(mtx);
+    if (nodes.empty())
+      return nullptr;
+    size_t index = generator() % nodes.size();
+    std::swap(nodes[index], nodes.back());
+    shared_ptr<LockFreeNode<uint64_t>> node = std::move(nodes.back());
+    nodes.pop_back();
+    return node;
   }
+};
 
-  for (int i = 0; i < 99; ++i) {
-    threads03.push_back(std::thread(
-        [&](int n) {
-          while (true) {
-            shared_ptr<LockFreeNode<uint64_t>> node =
-                nodes01[n].remove_node();
-            if (node == nullptr) {
-              printf("no node to remove\n");
-              std::this_thread::sleep_for(std::chrono::seconds(10));
-              continue;
-            }
-
-            if (!list.Remove(shared_ptr<LockFreeNode<uint64_t>>(node))) {
-              std::cout << "-------------- remove failed" << std::endl;
-              std::this_thread::sleep_for(std::chrono::seconds(1));
-            } else {
-              std::cout << "-------------- remove " << node << std::endl;
-            }
-          }
-        },
-        i));
-  }
+struct Options {
+  int threads = 99;
+  int seconds = 10;
+  uint64_t ops = 1000;
+};
 
-  for (int i = 0; i < 99; ++i) {
-    threads04.push_back(std::thread(
-        [&](int n) {
-          while (true) {
-            shared_ptr<LockFreeNode<uint64_t>> node =
-                nodes02[n].remove_node();
-            if (node == nullptr) {
-              printf("no node to remove\n");
-              std::this_thread::sleep_for(std::chrono::seconds(10));
-              continue;
-            }
-
-            if (!list.Remove(shared_ptr<LockFreeNode<uint64_t>>(node))) {
-              std::cout << "-------------- remove failed" << std::endl;
-              std::this_thread::sleep_for(std::chrono::seconds(1));
-            } else {
-              std::cout << "-------------- remove2 " << node << std::endl;
-            }
-          }
-        },
-        i));
+Options parse_options(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (strcmp(argv[i], "--threads") == 0)
+      options.threads = std::max(1, atoi(argv[i + 1]));
+    else if (strcmp(argv[i], "--seconds") == 0)
+      options.seconds = std::max(1, atoi(argv[i + 1]));
+    else if (strcmp(argv[i], "--ops") == 0)
+      options.ops = strtoull(argv[i + 1], nullptr, 10);
   }
+  return options;
+}
 
-  auto thread = std::thread([&]() {
-    while (true) {
-      std::cout << "size: " << list.Size() << std::endl;
-      std::this_thread::sleep_for(std::chrono::seconds(1));
-    }
-  });
-  thread.join();
+uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Times one list operation into the histogram of the thread
+template <typename OPERATION>
+bool timed(ThreadStats& stats, OPERATION operation) {
+  uint64_t begin = now_ns();
+  bool success = operation();
+  stats.latency.record(now_ns() - begin);
+  if (!success)
+    stats.failures++;
+  return success;
+}
 
-  for (auto& thread : threads01) {
-    if (thread.joinable()) {
-      thread.join();
+void print_stats(const std::vector<std::unique_ptr<ThreadStats>>& stats) {
+  printf("%-12s %12s %10s %10s %10s %10s %12s %9s\n", "operation", "count", "p50(ns)", "p99(ns)", "p99.9(ns)",
+         "max(ns)", "ops/thread", "failures");
+  for (int operation = 0; operation < kOperationCount; operation++) {
+    LatencyHistogram merged;
+    uint64_t failures = 0;
+    int threads = 0;
+    for (auto& thread_stats : stats) {
+      if (thread_stats->operation != operation)
+        continue;
+      merged.merge(thread_stats->latency);
+      failures += thread_stats->failures;
+      threads++;
     }
+    printf("%-12s %12llu %10llu %10llu %10llu %10llu %12llu %9llu\n", operation_name(operation),
+           (unsigned long long)merged.total(), (unsigned long long)merged.percentile(0.5),
+           (unsigned long long)merged.percentile(0.99), (unsigned long long)merged.percentile(0.999),
+           (unsigned long long)merged.max(), (unsigned long long)(threads > 0 ? merged.total() / threads : 0),
+           (unsigned long long)failures);
   }
+}
 
-  for (auto& thread : threads02) {
-    if (thread.joinable()) {
-      thread.join();
-    }
+int main(int argc, char** argv) {
+  Options options = parse_options(argc, argv);
+  printf("threads per group: %d, seconds: %d, ops per inserting thread: %llu\n", options.threads, options.seconds,
+         (unsigned long long)options.ops);
+
+  LockFreeSiList<uint64_t> list;
+  std::vector<NodesItem> nodes01(options.threads);
+  std::vector<NodesItem> nodes02(options.threads);
+  std::vector<std::unique_ptr<ThreadStats>> stats;
+  std::vector<std::thread> threads;
+  std::atomic<bool> stop(false);
+  std::atomic<int> inserting(2 * options.threads);
+  std::atomic<int> running(4 * options.threads);
+  uint64_t seed = std::chrono::system_clock::now().time_since_epoch().count();
+
+  for (int group = 0; group < 4; group++) {
+    Operation operation = group == 0 ? kAppend : group == 1 ? kInsertHead : kRemove;
+    for (int i = 0; i < options.threads; i++)
+      stats.emplace_back(new ThreadStats(operation));
   }
 
-  for (auto& thread : threads03) {
-    if (thread.joinable()) {
-      thread.join();
-    }
+  for (int i = 0; i < 2 * options.threads; i++) {
+    bool append = i < options.threads;
+    int n = i % options.threads;
+    ThreadStats& thread_stats = *stats[i];
+    NodesItem& removable = append ? nodes01[n] : nodes02[n];
+    threads.push_back(std::thread([&, append, i]() {
+      std::mt19937_64 generator(seed + i);
+      for (uint64_t count = 0; !stop.load(std::memory_order_relaxed) && (options.ops == 0 || count < options.ops);
+           count++) {
+        shared_ptr<LockFreeNode<uint64_t>> node = make_shared<LockFreeNode<uint64_t>>(generator());
+        if (timed(thread_stats, [&]() { return append ? list.Append(node) : list.InsertHead(node); }))
+          removable.add_node(std::move(node));
+      }
+      inserting--;
+      running--;
+    }));
   }
 
-  for (auto& thread : threads04) {
-    if (thread.joinable()) {
-      thread.join();
-    }
+  for (int i = 0; i < 2 * options.threads; i++) {
+    int n = i % options.threads;
+    ThreadStats& thread_stats = *stats[2 * options.threads + i];
+    NodesItem& removable = i < options.threads ? nodes01[n] : nodes02[n];
+    threads.push_back(std::thread([&, i]() {
+      std::mt19937_64 generator(seed + 2 * options.threads + i);
+      // removes the nodes of its inserting thread until all inserting threads are done and its item is empty
+      while (!stop.load(std::memory_order_relaxed)) {
+        shared_ptr<LockFreeNode<uint64_t>> node = removable.remove_node(generator);
+        if (node == nullptr) {
+          if (inserting.load() == 0)
+            break;
+          std::this_thread::yield();
+          continue;
+        }
+        timed(thread_stats, [&]() { return list.Remove(node); });
+      }
+      running--;
+    }));
   }
 
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(options.seconds);
+  while (std::chrono::steady_clock::now() < deadline && running.load() > 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  stop.store(true);
+  for (auto& thread : threads)
+    thread.join();
+
+  print_stats(stats);
+  printf("size: %lld\n", (long long)list.Size());
+
+  // every node still linked is held by the item of its inserting thread, unlink them all so that the long chains are
+  // not released recursively on destruction
+  for (auto* items : {&nodes01, &nodes02})
+    for (auto& item : *items)
+      for (auto& node : item.nodes)
+        node->SetNext(nullptr);
   return 0;
 }
@@ -0,0 +1,313 @@
+#ifndef EPOCH_RECLAIM_H
+#define EPOCH_RECLAIM_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "lockfree_reclaim.h"
+
+/**
+ * Process wide epoch based reclamation domain.
+ * A thread pins the global epoch while it is inside a critical section (see EpochGuard),
+ * a retired node goes to the limbo list of its thread tagged with the epoch it was retired in.
+ * The global epoch only advances when every pinned thread has observed the current one,
+ * so no reader holds a node retired in epoch e from a link of the list once the global epoch reaches e + 2.
+ * It is freed at e + 3: a reader pinned in e + 1 may still load it from a hint of the lists (tail_ or prev_)
+ * whose writer, pinned in e, has not settled the hint yet.
+ */
+class EpochDomain {
+public:
+    static const size_t kRetireBatch = 64;
+
+    static EpochDomain& Instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    ~EpochDomain() {
+        Record* record = records_.load();
+        while (record != nullptr) {
+            Record* nextRecord = record->next;
+            for (Retired& retired : record->limbo)
+                retired.deleter(retired.node);
+            delete record;
+            record = nextRecord;
+        }
+    }
+
+    /**
+     * Enters a critical section, nested sections only pin the epoch once.
+     */
+    void Enter() {
+        Record* record = localRecord();
+        if (record->nesting++ == 0) {
+            record->epoch.store((globalEpoch_.load() << 1) | 1);
+            atomic_thread_fence(memory_order_seq_cst);
+        }
+    }
+
+    void Exit() {
+        Record* record = localRecord();
+        if (--record->nesting == 0)
+            record->epoch.store(0, memory_order_release);
+    }
+
+    uint64_t Epoch() const {
+        return globalEpoch_.load();
+    }
+
+    /**
+     * Hands an unlinked node over to the domain, the node is freed three epochs later.
+     * The caller must grant the node is no longer reachable from the list.
+     *
+     * @param node The removed node.
+     * @param deleter The function to free the node.
+     */
+    void Retire(void* node, void (*deleter)(void*)) {
+        Record* record = localRecord();
+        record->limbo.push_back(Retired{node, deleter, globalEpoch_.load()});
+        if (record->limbo.size() >= record->collectAt) {
+            tryAdvance();
+            collect(record);
+            // while a pinned thread holds the epoch back, collect less often instead of rescanning the limbo list
+            record->collectAt = max(size_t(kRetireBatch), 2 * record->limbo.size());
+        }
+    }
+
+    /**
+     * Tries to advance the epoch and frees every node of the calling thread retired at least three epochs ago,
+     * the nodes left behind by exited threads are adopted first.
+     */
+    void Flush() {
+        Record* owner = localRecord();
+        for (Record* record = records_.load(); record != nullptr; record = record->next) {
+            bool inactive = false;
+            if (record == owner || !record->active.compare_exchange_strong(inactive, true))
+                continue;
+            owner->limbo.insert(owner->limbo.end(), record->limbo.begin(), record->limbo.end());
+            record->limbo.clear();
+            record->active.store(false, memory_order_release);
+        }
+        tryAdvance();
+        tryAdvance();
+        tryAdvance();
+        collect(owner);
+    }
+
+private:
+    struct Retired {
+        void* node;
+        void (*deleter)(void*);
+        uint64_t epoch;
+    };
+
+    struct Record {
+        Record* next = nullptr;
+        atomic<bool> active{true};
+        // (pinned epoch << 1) | 1 inside a critical section, 0 outside
+        atomic<uint64_t> epoch{0};
+        int nesting = 0;
+        size_t collectAt = kRetireBatch;
+        vector<Retired> limbo;
+    };
+
+    struct LocalRecord {
+        Record* record = nullptr;
+
+        ~LocalRecord() {
+            if (record == nullptr)
+                return;
+            EpochDomain& domain = EpochDomain::Instance();
+            domain.tryAdvance();
+            domain.collect(record);
+            record->active.store(false, memory_order_release);
+        }
+    };
+
+    atomic<Record*> records_{nullptr};
+    atomic<uint64_t> globalEpoch_{0};
+
+    EpochDomain() {}
+
+    Record* localRecord() {
+        static thread_local LocalRecord local;
+        if (local.record == nullptr)
+            local.record = acquireRecord();
+        return local.record;
+    }
+
+    Record* acquireRecord() {
+        for (Record* record = records_.load(); record != nullptr; record = record->next) {
+            bool inactive = false;
+            if (!record->active.load(memory_order_relaxed) && record->active.compare_exchange_strong(inactive, true))
+                return record;
+        }
+        Record* record = new Record();
+        Record* head = records_.load();
+        do {
+            record->next = head;
+        } while (!records_.compare_exchange_weak(head, record));
+        return record;
+    }
+
+    bool tryAdvance() {
+        uint64_t epoch = globalEpoch_.load();
+        for (Record* record = records_.load(); record != nullptr; record = record->next) {
+            uint64_t pinned = record->epoch.load();
+            if ((pinned & 1) != 0 && (pinned >> 1) != epoch)
+                return false;
+        }
+        return globalEpoch_.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+    void collect(Record* owner) {
+        uint64_t epoch = globalEpoch_.load();
+        size_t kept = 0;
+        for (Retired& retired : owner->limbo) {
+            if (retired.epoch + 3 <= epoch)
+                retired.deleter(retired.node);
+            else
+                owner->limbo[kept++] = retired;
+        }
+        owner->limbo.resize(kept);
+    }
+};
+
+/**
+ * Scoped critical section of the epoch domain.
+ * Every node loaded while the guard lives stays readable until the guard is destroyed,
+ * hold one around a whole traversal instead of paying the pin on every step.
+ */
+class EpochGuard {
+public:
+    EpochGuard() {
+        EpochDomain::Instance().Enter();
+    }
+
+    ~EpochGuard() {
+        EpochDomain::Instance().Exit();
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+/**
+ * Plain pointer handle of EpochReclaim, the protection comes from the enclosing EpochGuard.
+ */
+template<typename T>
+class EpochPtr {
+public:
+    EpochPtr() : ptr_(nullptr) {}
+
+    EpochPtr(nullptr_t) : ptr_(nullptr) {}
+
+    EpochPtr(T* node) : ptr_(node) {}
+
+    template<typename U, typename = typename enable_if<is_convertible<U*, T*>::value>::type>
+    EpochPtr(const EpochPtr<U>& other) : ptr_(other.get()) {}
+
+    static EpochPtr Protect(const atomic<T*>& src) {
+        return EpochPtr(src.load());
+    }
+
+    T* get() const {
+        return ptr_;
+    }
+
+    T* operator->() const {
+        return ptr_;
+    }
+
+    T& operator*() const {
+        return *ptr_;
+    }
+
+    explicit operator bool() const {
+        return ptr_ != nullptr;
+    }
+
+private:
+    T* ptr_;
+};
+
+template<typename T, typename U>
+inline bool operator==(const EpochPtr<T>& a, const EpochPtr<U>& b) {
+    return a.get() == b.get();
+}
+
+template<typename T, typename U>
+inline bool operator!=(const EpochPtr<T>& a, const EpochPtr<U>& b) {
+    return a.get() != b.get();
+}
+
+template<typename T>
+inline bool operator==(const EpochPtr<T>& a, nullptr_t) {
+    return a.get() == nullptr;
+}
+
+template<typename T>
+inline bool operator==(nullptr_t, const EpochPtr<T>& a) {
+    return a.get() == nullptr;
+}
+
+template<typename T>
+inline bool operator!=(const EpochPtr<T>& a, nullptr_t) {
+    return a.get() != nullptr;
+}
+
+template<typename T>
+inline bool operator!=(nullptr_t, const EpochPtr<T>& a) {
+    return a.get() != nullptr;
+}
+
+/**
+ * Reclamation policy storing raw pointers in the nodes, readers pay no per-node cost.
+ * Every list operation runs inside an EpochGuard, the nodes it returns are only readable while the caller
+ * holds its own guard, e.g. around a whole traversal.
+ * The list owns its nodes: Remove/PopHead/PopTail retire them into the limbo list of the calling thread,
+ * they are freed once the global epoch advanced three times, the list destructor deletes the rest.
+ */
+struct EpochReclaim : HeapAllocation {
+    static const bool kOwnsNodes = true;
+    static const bool kGuardProtects = true;
+
+    using Guard = EpochGuard;
+
+    template<typename N>
+    using Ptr = EpochPtr<N>;
+
+    template<typename N>
+    using Link = RawLink<N, EpochPtr<N>>;
+
+    template<typename To, typename From>
+    static Ptr<To> Cast(const Ptr<From>& node) {
+        return EpochPtr<To>(static_cast<To*>(node.get()));
+    }
+
+    template<typename N>
+    static Ptr<N> Unmanaged(N* node) {
+        return EpochPtr<N>(node);
+    }
+
+    template<typename N, typename... ARGS>
+    static Ptr<N> Make(ARGS&&... args) {
+        return EpochPtr<N>(new N(std::forward<ARGS>(args)...));
+    }
+
+    template<typename N>
+    static void Retire(const Ptr<N>& node) {
+        EpochDomain::Instance().Retire(node.get(), [](void* p) { delete static_cast<N*>(p); });
+    }
+
+    template<typename N>
+    static void Destroy(const Ptr<N>& node) {
+        delete node.get();
+    }
+};
+
+#endif //EPOCH_RECLAIM_H
@@ -0,0 +1,402 @@
+#ifndef HAZARD_POINTER_H
+#define HAZARD_POINTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "lockfree_reclaim.h"
+
+/**
+ * Process wide hazard pointer domain.
+ * Every thread owns a record with a growable set of hazard slots and a private list of retired nodes.
+ * A retired node is freed by a batched scan once no slot of any record publishes its address.
+ */
+class HazardPointerDomain {
+public:
+    static const int kSlotsPerChunk = 32;
+    static const size_t kRetireBatch = 64;
+
+    static HazardPointerDomain& Instance() {
+        static HazardPointerDomain domain;
+        return domain;
+    }
+
+    ~HazardPointerDomain() {
+        Record* record = records_.load();
+        while (record != nullptr) {
+            Record* nextRecord = record->next;
+            for (Retired& retired : record->retired)
+                retired.deleter(retired.node);
+            SlotChunk* chunk = record->chunks.next.load();
+            while (chunk != nullptr) {
+                SlotChunk* nextChunk = chunk->next.load();
+                delete chunk;
+                chunk = nextChunk;
+            }
+            delete record;
+            record = nextRecord;
+        }
+    }
+
+    atomic<void*>* AcquireSlot() {
+        Record* record = localRecord();
+        if (record->freeSlots.empty())
+            addChunk(record);
+        atomic<void*>* slot = record->freeSlots.back();
+        record->freeSlots.pop_back();
+        return slot;
+    }
+
+    void ReleaseSlot(atomic<void*>* slot) {
+        slot->store(nullptr, memory_order_release);
+        localRecord()->freeSlots.push_back(slot);
+    }
+
+    /**
+     * Hands an unlinked node over to the domain, the node is freed by a later scan.
+     * The caller must grant the node is no longer reachable from the list.
+     *
+     * @param node The removed node.
+     * @param deleter The function to free the node.
+     */
+    void Retire(void* node, void (*deleter)(void*)) {
+        Record* record = localRecord();
+        record->retired.push_back(Retired{node, deleter});
+        if (record->retired.size() >= kRetireBatch + 2 * slotCount_.load(memory_order_relaxed))
+            scan(record);
+    }
+
+    /**
+     * Frees every retired node of the calling thread which is not protected any more,
+     * the nodes left behind by exited threads are adopted first.
+     */
+    void Flush() {
+        Record* owner = localRecord();
+        for (Record* record = records_.load(); record != nullptr; record = record->next) {
+            bool inactive = false;
+            if (record == owner || !record->active.compare_exchange_strong(inactive, true))
+                continue;
+            owner->retired.insert(owner->retired.end(), record->retired.begin(), record->retired.end());
+            record->retired.clear();
+            record->active.store(false, memory_order_release);
+        }
+        scan(owner);
+    }
+
+private:
+    struct Retired {
+        void* node;
+        void (*deleter)(void*);
+    };
+
+    struct SlotChunk {
+        atomic<void*> slots[kSlotsPerChunk];
+        atomic<SlotChunk*> next;
+
+        SlotChunk() : next(nullptr) {
+            for (atomic<void*>& slot : slots)
+                slot.store(nullptr, memory_order_relaxed);
+        }
+    };
+
+    struct Record {
+        Record* next = nullptr;
+        atomic<bool> active{true};
+        SlotChunk chunks;
+        vector<atomic<void*>*> freeSlots;
+        vector<Retired> retired;
+    };
+
+    struct LocalRecord {
+        Record* record = nullptr;
+
+        ~LocalRecord() {
+            if (record == nullptr)
+                return;
+            HazardPointerDomain::Instance().scan(record);
+            record->active.store(false, memory_order_release);
+        }
+    };
+
+    atomic<Record*> records_{nullptr};
+    atomic<size_t> slotCount_{0};
+
+    HazardPointerDomain() {}
+
+    Record* localRecord() {
+        static thread_local LocalRecord local;
+        if (local.record == nullptr)
+            local.record = acquireRecord();
+        return local.record;
+    }
+
+    Record* acquireRecord() {
+        for (Record* record = records_.load(); record != nullptr; record = record->next) {
+            bool inactive = false;
+            if (!record->active.load(memory_order_relaxed) && record->active.compare_exchange_strong(inactive, true))
+                return record;
+        }
+        Record* record = new Record();
+        for (atomic<void*>& slot : record->chunks.slots)
+            record->freeSlots.push_back(&slot);
+        slotCount_.fetch_add(kSlotsPerChunk, memory_order_relaxed);
+        Record* head = records_.load();
+        do {
+            record->next = head;
+        } while (!records_.compare_exchange_weak(head, record));
+        return record;
+    }
+
+    void addChunk(Record* record) {
+        SlotChunk* chunk = new SlotChunk();
+        for (atomic<void*>& slot : chunk->slots)
+            record->freeSlots.push_back(&slot);
+        // Only the owner thread appends chunks, scanners just follow the chain.
+        SlotChunk* last = &record->chunks;
+        while (last->next.load() != nullptr)
+            last = last->next.load();
+        last->next.store(chunk);
+        slotCount_.fetch_add(kSlotsPerChunk, memory_order_relaxed);
+    }
+
+    void scan(Record* owner) {
+        vector<void*> hazards;
+        for (Record* record = records_.load(); record != nullptr; record = record->next) {
+            for (SlotChunk* chunk = &record->chunks; chunk != nullptr; chunk = chunk->next.load()) {
+                for (atomic<void*>& slot : chunk->slots) {
+                    void* hazard = slot.load();
+                    if (hazard != nullptr)
+                        hazards.push_back(hazard);
+                }
+            }
+        }
+        sort(hazards.begin(), hazards.end());
+
+        vector<Retired> kept;
+        for (Retired& retired : owner->retired) {
+            if (binary_search(hazards.begin(), hazards.end(), retired.node))
+                kept.push_back(retired);
+            else
+                retired.deleter(retired.node);
+        }
+        owner->retired.swap(kept);
+    }
+};
+
+/**
+ * Handle of a node protected by a hazard slot, the node is not freed while the handle lives.
+ * Copying a handle publishes the node in another slot, moving transfers the slot.
+ */
+template<typename T>
+class HazardPtr {
+public:
+    HazardPtr() : ptr_(nullptr), slot_(nullptr) {}
+
+    HazardPtr(nullptr_t) : ptr_(nullptr), slot_(nullptr) {}
+
+    /**
+     * Protects a node which is not yet published or is kept alive by the caller.
+     */
+    explicit HazardPtr(T* node) : ptr_(node), slot_(nullptr) {
+        protect();
+    }
+
+    HazardPtr(const HazardPtr& other) : ptr_(other.ptr_), slot_(nullptr) {
+        if (other.slot_ != nullptr)
+            protect();
+    }
+
+    HazardPtr(HazardPtr&& other) : ptr_(other.ptr_), slot_(other.slot_) {
+        other.ptr_ = nullptr;
+        other.slot_ = nullptr;
+    }
+
+    template<typename U, typename = typename enable_if<is_convertible<U*, T*>::value>::type>
+    HazardPtr(const HazardPtr<U>& other) : ptr_(other.get()), slot_(nullptr) {
+        if (other.isProtected())
+            protect();
+    }
+
+    ~HazardPtr() {
+        release();
+    }
+
+    HazardPtr& operator=(const HazardPtr& other) {
+        if (this != &other) {
+            release();
+            ptr_ = other.ptr_;
+            if (other.slot_ != nullptr)
+                protect();
+        }
+        return *this;
+    }
+
+    HazardPtr& operator=(HazardPtr&& other) {
+        if (this != &other) {
+            release();
+            ptr_ = other.ptr_;
+            slot_ = other.slot_;
+            other.ptr_ = nullptr;
+            other.slot_ = nullptr;
+        }
+        return *this;
+    }
+
+    HazardPtr& operator=(nullptr_t) {
+        release();
+        return *this;
+    }
+
+    /**
+     * Loads a pointer from src and publishes it, retrying until src still holds the published value,
+     * so the node can not have been retired and scanned in between.
+     */
+    static HazardPtr Protect(const atomic<T*>& src) {
+        T* node = src.load();
+        if (node == nullptr)
+            return HazardPtr();
+        atomic<void*>* slot = HazardPointerDomain::Instance().AcquireSlot();
+        while (true) {
+            slot->store(node);
+            T* current = src.load();
+            if (current == node)
+                return HazardPtr(node, slot);
+            node = current;
+            if (node == nullptr) {
+                HazardPointerDomain::Instance().ReleaseSlot(slot);
+                return HazardPtr();
+            }
+        }
+    }
+
+    /**
+     * A handle without slot, only for nodes which are never freed, e.g. the deletion sentinel.
+     */
+    static HazardPtr Unprotected(T* node) {
+        return HazardPtr(node, nullptr);
+    }
+
+    T* get() const {
+        return ptr_;
+    }
+
+    T* operator->() const {
+        return ptr_;
+    }
+
+    T& operator*() const {
+        return *ptr_;
+    }
+
+    explicit operator bool() const {
+        return ptr_ != nullptr;
+    }
+
+    bool isProtected() const {
+        return slot_ != nullptr;
+    }
+
+private:
+    T* ptr_;
+    atomic<void*>* slot_;
+
+    HazardPtr(T* node, atomic<void*>* slot) : ptr_(node), slot_(slot) {}
+
+    void protect() {
+        if (ptr_ == nullptr)
+            return;
+        slot_ = HazardPointerDomain::Instance().AcquireSlot();
+        slot_->store(ptr_);
+    }
+
+    void release() {
+        if (slot_ != nullptr)
+            HazardPointerDomain::Instance().ReleaseSlot(slot_);
+        ptr_ = nullptr;
+        slot_ = nullptr;
+    }
+};
+
+template<typename T, typename U>
+inline bool operator==(const HazardPtr<T>& a, const HazardPtr<U>& b) {
+    return a.get() == b.get();
+}
+
+template<typename T, typename U>
+inline bool operator!=(const HazardPtr<T>& a, const HazardPtr<U>& b) {
+    return a.get() != b.get();
+}
+
+template<typename T>
+inline bool operator==(const HazardPtr<T>& a, nullptr_t) {
+    return a.get() == nullptr;
+}
+
+template<typename T>
+inline bool operator==(nullptr_t, const HazardPtr<T>& a) {
+    return a.get() == nullptr;
+}
+
+template<typename T>
+inline bool operator!=(const HazardPtr<T>& a, nullptr_t) {
+    return a.get() != nullptr;
+}
+
+template<typename T>
+inline bool operator!=(nullptr_t, const HazardPtr<T>& a) {
+    return a.get() != nullptr;
+}
+
+template<typename To, typename From>
+inline HazardPtr<To> static_pointer_cast(const HazardPtr<From>& node) {
+    if (!node.isProtected())
+        return HazardPtr<To>::Unprotected(static_cast<To*>(node.get()));
+    return HazardPtr<To>(static_cast<To*>(node.get()));
+}
+
+/**
+ * Reclamation policy storing raw pointers in the nodes and protecting every loaded pointer with a hazard slot.
+ * The list owns its nodes: Remove/PopHead/PopTail retire them and the list destructor deletes the rest.
+ */
+struct HazardPointerReclaim : HeapAllocation {
+    static const bool kOwnsNodes = true;
+    static const bool kGuardProtects = false;
+
+    using Guard = NoReclaimGuard;
+
+    template<typename N>
+    using Ptr = HazardPtr<N>;
+
+    template<typename N>
+    using Link = RawLink<N, HazardPtr<N>>;
+
+    template<typename To, typename From>
+    static Ptr<To> Cast(const Ptr<From>& node) {
+        return static_pointer_cast<To>(node);
+    }
+
+    template<typename N>
+    static Ptr<N> Unmanaged(N* node) {
+        return HazardPtr<N>::Unprotected(node);
+    }
+
+    template<typename N, typename... ARGS>
+    static Ptr<N> Make(ARGS&&... args) {
+        return HazardPtr<N>(new N(std::forward<ARGS>(args)...));
+    }
+
+    template<typename N>
+    static void Retire(const Ptr<N>& node) {
+        HazardPointerDomain::Instance().Retire(node.get(), [](void* p) { delete static_cast<N*>(p); });
+    }
+
+    template<typename N>
+    static void Destroy(const Ptr<N>& node) {
+        delete node.get();
+    }
+};
+
+#endif //HAZARD_POINTER_H
@@ -0,0 +1,143 @@
+#ifndef LOCKFREE_BACKOFF_H
+#define LOCKFREE_BACKOFF_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include "lockfree_util.h"
+
+using namespace std;
+
+/**
+ * A backoff policy paces the retries of a list operation whose CAS failed. Every operation which retries
+ * (Append, Insert, InsertHead, Remove, PopHead, PopTail) creates one BACKOFF on the stack, so a policy object lives
+ * as long as one operation. Every policy provides:
+ *   Wait()   called after every failed attempt, before the retry.
+ */
+
+/**
+ * Default policy: retry at once.
+ */
+struct NoBackoff {
+    void Wait() {}
+};
+
+/**
+ * Spins count CpuRelax() instructions.
+ */
+inline void BackoffSpin(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++)
+        CpuRelax();
+}
+
+/**
+ * Per-thread xorshift, the jitter of the backoff policies, no need for a good distribution.
+ */
+inline uint32_t BackoffRandom() {
+    static thread_local uint32_t state = 2463534242u ^ static_cast<uint32_t>(hash<thread::id>()(this_thread::get_id()));
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/**
+ * Randomized exponential backoff: after the n-th failure the thread spins a random count in [1, MIN_SPINS << n],
+ * capped at MAX_SPINS. The jitter keeps the threads which failed on the same CAS from retrying together.
+ */
+template<uint32_t MIN_SPINS = 4, uint32_t MAX_SPINS = 4096>
+class ExponentialBackoff {
+public:
+    ExponentialBackoff() : limit_(MIN_SPINS) {}
+
+    void Wait() {
+        BackoffSpin(BackoffRandom() % limit_ + 1);
+        limit_ = min(limit_ * 2, MAX_SPINS);
+    }
+
+private:
+    uint32_t limit_;
+};
+
+/**
+ * Spins 1, 2, 4, ... CpuRelax() for the first SPIN_FAILURES failures, then yields the CPU on every failure,
+ * for oversubscribed threads which would only spin against a preempted CAS winner.
+ */
+template<uint32_t SPIN_FAILURES = 8>
+class SpinYieldBackoff {
+public:
+    SpinYieldBackoff() : failures_(0) {}
+
+    void Wait() {
+        if (failures_ < SPIN_FAILURES)
+            BackoffSpin(uint32_t(1) << failures_++);
+        else
+            this_thread::yield();
+    }
+
+private:
+    uint32_t failures_;
+};
+
+/**
+ * Exponential backoff starting from the recent failure rate of the thread: a thread whose operations rarely fail
+ * retries almost at once, one whose operations kept failing starts with a longer wait. Past MAX_SPINS it yields.
+ * The rate is the failures per operation, times 16, averaged over about the last 8 operations of the thread.
+ */
+template<uint32_t MAX_SPINS = 4096>
+class AdaptiveBackoff {
+public:
+    AdaptiveBackoff() : failures_(0), limit_(failureRate() / 4 + 1) {}
+
+    ~AdaptiveBackoff() {
+        uint32_t& rate = failureRate();
+        rate = rate - rate / 8 + min(failures_, uint32_t(64)) * 16 / 8;
+    }
+
+    void Wait() {
+        failures_++;
+        if (limit_ >= MAX_SPINS) {
+            this_thread::yield();
+            return;
+        }
+        limit_ = min(limit_ * 2, MAX_SPINS);
+        BackoffSpin(BackoffRandom() % limit_ + 1);
+    }
+
+private:
+    uint32_t failures_;
+    uint32_t limit_;
+
+    static uint32_t& failureRate() {
+        static thread_local uint32_t rate = 0;
+        return rate;
+    }
+};
+
+/**
+ * The failed CAS counted by CountingBackoff on the calling thread so far, whatever the list.
+ */
+inline uint64_t& BackoffFailures() {
+    static thread_local uint64_t failures = 0;
+    return failures;
+}
+
+/**
+ * Counts every failure in BackoffFailures(), then waits as BACKOFF does. The count is the contention signal of
+ * the adaptive mode of LockFreeCombiningList (lockfree_combining.h).
+ */
+template<typename BACKOFF = NoBackoff>
+class CountingBackoff {
+public:
+    void Wait() {
+        BackoffFailures()++;
+        backoff_.Wait();
+    }
+
+private:
+    BACKOFF backoff_;
+};
+
+#endif //LOCKFREE_BACKOFF_H
@@ -6,125 +6,97 @@
 #define LOCKFREE_BILIST_H
 
 #include "lockfree_binode.h"
+#include "lockfree_hook.h"
 #include "lockfree_list.h"
+#include "lockfree_marked_list.h"
+
+/**
+ * NODE switches the deletion scheme: LockFreeBiNode (default) deletes by linking the dummyNode sentinel,
+ * LockFreeMarkedBiNode marks next_ and keeps the successor (see lockfree_marked_list.h),
+ * LockFreeIntrusiveNode links the objects of a T deriving from LockFreeBiHook directly (see lockfree_hook.h).
+ * LAYOUT places the control words of the list, see lockfree_layout.h. BACKOFF paces the retries after a failed CAS,
+ * see lockfree_backoff.h. STATS counts the contention inside the list, see lockfree_stats.h.
+ */
+template<typename T, typename RECLAIM = SharedPtrReclaim, template<typename, typename> class NODE = LockFreeBiNode,
+         typename COUNTER = ExactCounter, typename LAYOUT = CompactLayout, typename BACKOFF = NoBackoff,
+         typename STATS = NoStats>
+class LockFreeBiList
+    : public LockFreeList<NODE<T, RECLAIM>, RECLAIM, COUNTER, LAYOUT, BACKOFF, STATS,
+                          LockFreeBiList<T, RECLAIM, NODE, COUNTER, LAYOUT, BACKOFF, STATS>> {
+    using Base = LockFreeList<NODE<T, RECLAIM>, RECLAIM, COUNTER, LAYOUT, BACKOFF, STATS, LockFreeBiList>;
+    friend Base;
+
+public:
+    using NodePtr = typename Base::NodePtr;
+    using reverse_iterator = LockFreeListIterator<Base, true>;
+
+    /**
+     * Weakly consistent iteration from the tail backward, see lockfree_iterator.h.
+     */
+    reverse_iterator rbegin() {
+        return reverse_iterator(this, this->Tail());
+    }
+
+    reverse_iterator rend() {
+        return reverse_iterator(this, nullptr);
+    }
 
-template<typename T>
-class LockFreeBiList : public LockFreeList<LockFreeBiNode<T>> {
 protected:
-    inline void setPrev(shared_ptr<LockFreeBiNode<T>> node, shared_ptr<LockFreeBiNode<T>> prevNode) override {
+    inline void setPrev(const NodePtr& node, const NodePtr& prevNode) {
         node->SetPrev(prevNode);
     }
 
-    inline shared_ptr<LockFreeBiNode<T>> getPrev(shared_ptr<LockFreeBiNode<T>> node) override {
-        return node->Prev();
+    inline bool compareAndSetPrev(const NodePtr& node, const NodePtr& oldPrev, const NodePtr& newPrev) {
+        return node->CompareAndSetPrev(oldPrev, newPrev);
     }
 
-    inline bool hasPrev() override {
-        return true;
+    inline NodePtr getPrev(const NodePtr& node) {
+        return node->Prev();
     }
 
-    void deleteNodeBetween(shared_ptr<LockFreeBiNode<T>> node, shared_ptr<LockFreeBiNode<T>> prevNode, shared_ptr<LockFreeBiNode<T>> nextNode) override {
-        shared_ptr<LockFreeBiNode<T>> actualNextNode = this->getValidNext(node); // maybe not same as origNextNode
-        if (actualNextNode == node)
-            actualNextNode = nullptr;
-        shared_ptr<LockFreeBiNode<T>> actualPrevNode = getValidPrev(node);
-        bool result;
-        if (actualPrevNode != nullptr) {
-            result = this->updateNext(actualPrevNode, actualNextNode);
-        } else {
-            result = updateHead(this->Head(), actualNextNode);
-        }
-
-        if (actualNextNode != nullptr) {
-            updatePrev(actualNextNode, actualPrevNode);
-        } else {
-            this->updateTail(this->Tail(), actualPrevNode);
-        }
-        if (actualPrevNode != nullptr || actualNextNode != nullptr) {
-            if (!result || actualPrevNode != prevNode || actualNextNode != nextNode)
-                fixDelete(prevNode, nextNode);
-        }
+    static constexpr bool hasPrev() {
+        return true;
     }
 
-    bool isWrongConnection(shared_ptr<LockFreeBiNode<T>> node, shared_ptr<LockFreeBiNode<T>> nextNode) override {
+    bool isWrongConnection(const NodePtr& node, const NodePtr& nextNode) {
         return nextNode->Prev() != node || node->Next() != nextNode;
     }
+};
 
-    shared_ptr<LockFreeBiNode<T>> getValidPrev(shared_ptr<LockFreeBiNode<T>> node) override {
-        if (nullptr == node)
-            return nullptr;
-        shared_ptr<LockFreeBiNode<T>> prevNode = node->Prev();
-        while (prevNode != nullptr && prevNode->isDeleted()) {
-            prevNode = prevNode->Prev();
-        }
-        return prevNode;
+template<typename T, typename RECLAIM, typename COUNTER, typename LAYOUT, typename BACKOFF, typename STATS>
+class LockFreeBiList<T, RECLAIM, LockFreeMarkedBiNode, COUNTER, LAYOUT, BACKOFF, STATS>
+    : public LockFreeMarkedList<LockFreeMarkedBiNode<T, RECLAIM>, RECLAIM, COUNTER, LAYOUT, BACKOFF, STATS,
+                                LockFreeBiList<T, RECLAIM, LockFreeMarkedBiNode, COUNTER, LAYOUT, BACKOFF, STATS>> {
+    using Base = LockFreeMarkedList<LockFreeMarkedBiNode<T, RECLAIM>, RECLAIM, COUNTER, LAYOUT, BACKOFF, STATS,
+                                    LockFreeBiList>;
+    friend Base;
+
+public:
+    using NodePtr = typename Base::NodePtr;
+    using reverse_iterator = LockFreeListIterator<Base, true>;
+
+    /**
+     * Weakly consistent iteration from the tail backward, see lockfree_iterator.h.
+     */
+    reverse_iterator rbegin() {
+        return reverse_iterator(this, this->Tail());
     }
 
-private:
-    void fixPrev(shared_ptr<LockFreeBiNode<T>> nextNode, shared_ptr<LockFreeBiNode<T>> actualPrevNode, shared_ptr<LockFreeBiNode<T>> actualNextNode) override {
-        if (nextNode->isDeleted()) // may be changed
-            actualNextNode = this->getValidNext(nextNode);
-        if (actualNextNode == nullptr)
-            return;
-        if (actualPrevNode != nullptr) {
-            shared_ptr<LockFreeBiNode<T>> tempNode = actualPrevNode;
-            while (tempNode != nullptr && tempNode != actualNextNode->Next()) {
-                shared_ptr<LockFreeBiNode<T>> tempNext = static_pointer_cast<LockFreeBiNode<T>>(tempNode->Next());
-                shared_ptr<LockFreeBiNode<T>> temPrevOfNext = nullptr;
-                if (tempNext != nullptr)
-                    temPrevOfNext = getValidPrev(tempNext);
-                if (tempNext != nullptr && !tempNext->isDeleted() && temPrevOfNext != tempNext && tempNext->Prev() != tempNode) {
-                    if (temPrevOfNext == nullptr ||
-                        this->isNodeIn(temPrevOfNext, actualPrevNode, static_pointer_cast<LockFreeBiNode<T>>(actualNextNode->Next()), false)) {
-                        updatePrev(tempNext, tempNode);
-                    }
-                }
-                tempNode = tempNext;
-            }
-        }
+    reverse_iterator rend() {
+        return reverse_iterator(this, nullptr);
     }
 
-    void fixDelete(shared_ptr<LockFreeBiNode<T>> prevNode, shared_ptr<LockFreeBiNode<T>> nextNode) {
-        shared_ptr<LockFreeBiNode<T>> actualPrevNode = prevNode;
-        if (actualPrevNode != nullptr && actualPrevNode->isDeleted()) {
-            actualPrevNode = getValidPrev(prevNode);
-        }
-        shared_ptr<LockFreeBiNode<T>> actualNextNode = nextNode;
-        if (actualNextNode != nullptr && actualNextNode->isDeleted()) {
-            actualNextNode = this->getValidNext(nextNode);
-        }
-
-        if (actualPrevNode == nullptr)
-            updateHead(actualNextNode);
-
-        if ((actualNextNode == nullptr || actualPrevNode == actualNextNode))
-            this->updateTail(actualPrevNode);
-        else if (actualPrevNode != nullptr && actualNextNode != nextNode) {
-            this->updateNext(actualPrevNode, actualNextNode);
-        }
-
-        // Fix backward chain
-        if (actualPrevNode != nullptr && actualNextNode != nullptr)
-            fixPrev(nextNode, actualPrevNode, actualNextNode);
+protected:
+    inline void setPrev(const NodePtr& node, const NodePtr& prevNode) {
+        node->SetPrev(prevNode);
     }
 
-    bool updateHead(shared_ptr<LockFreeBiNode<T>> node, shared_ptr<LockFreeBiNode<T>>prevHead=nullptr) override {
-        bool result = LockFreeList<LockFreeBiNode<T>>::updateHead(node, prevHead);
-        if (result && node != nullptr) {
-            node->SetPrev(nullptr);
-        }
-        return result;
+    inline NodePtr getPrev(const NodePtr& node) const {
+        return node->Prev();
     }
 
-    void updatePrev(shared_ptr<LockFreeBiNode<T>> node, shared_ptr<LockFreeBiNode<T>> newNode, shared_ptr<LockFreeBiNode<T>> prevNode=nullptr) override {
-        if (prevNode == nullptr)
-            prevNode = node->Prev();
-        // avoid ABA
-        shared_ptr<LockFreeBiNode<T>> prevOfNewNode(nullptr);
-        if(newNode != nullptr)
-            prevOfNewNode = static_pointer_cast<LockFreeBiNode<T>>(newNode->Prev());
-        if (node != newNode && prevOfNewNode != node)
-            node->SetPrev(newNode);
+    static constexpr bool hasPrev() {
+        return true;
     }
 };
 
@@ -7,33 +7,34 @@
 
 #include "lockfree_node.h"
 
-template <typename T>
-struct LockFreeBiNode : LockFreeNode<T>
+template <typename T, typename RECLAIM = SharedPtrReclaim>
+struct LockFreeBiNode : LockFreeNode<T, RECLAIM>
 {
-    shared_ptr<LockFreeBiNode<T>> prev_;
+    using BiNodePtr = typename RECLAIM::template Ptr<LockFreeBiNode<T, RECLAIM>>;
 
-    LockFreeBiNode(T data) : LockFreeNode<T>(data) {}
+    typename RECLAIM::template Link<LockFreeBiNode<T, RECLAIM>> prev_;
 
-    virtual ~LockFreeBiNode() {}
+    LockFreeBiNode(T data) : LockFreeNode<T, RECLAIM>(std::move(data)) {}
 
-    // Override Next to return bidirectional node
-    shared_ptr<LockFreeNode<T>> Next() override {
-        // Cast the base class's next pointer to the derived class type
-        return LockFreeNode<T>::Next();
+    template<typename... ARGS, typename = typename enable_if<is_constructible<T, ARGS&&...>::value>::type>
+    explicit LockFreeBiNode(ARGS&&... args) : LockFreeNode<T, RECLAIM>(std::forward<ARGS>(args)...) {}
+
+    // Retrieve the previous node
+    BiNodePtr Prev() {
+        return prev_.Load();
     }
 
-    // Check if this node is logically deleted
-    bool isDeleted() override {
-        return LockFreeNode<T>::isDeleted();
+    // The previous node for prefetching only, it may be stale or nullptr
+    const void* PrevHint() const {
+        return prev_.Hint();
     }
 
-    // Retrieve the previous node
-    shared_ptr<LockFreeBiNode<T>> Prev() {
-        return atomic_load(&prev_);
+    void SetPrev(const BiNodePtr& node) {
+        prev_.Store(node);
     }
 
-    void SetPrev(shared_ptr<LockFreeBiNode<T>> node) {
-        atomic_store(&prev_, node);
+    bool CompareAndSetPrev(const BiNodePtr& oldPrev, const BiNodePtr& newPrev) {
+        return prev_.CompareAndSet(oldPrev, newPrev);
     }
 };
 #endif //BINODE_H
@@ -0,0 +1,223 @@
+#ifndef LOCKFREE_COMBINING_H
+#define LOCKFREE_COMBINING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "lockfree_backoff.h"
+#include "lockfree_layout.h"
+#include "lockfree_util.h"
+
+using namespace std;
+
+enum class CombiningMode {
+    kAdaptive,  // lock-free until the CAS failures climb, combining until the batches shrink
+    kLockFree,  // every thread runs its own operation on the list
+    kCombining, // every operation goes through the combiner
+};
+
+/**
+ * Flat combining (Hendler, Incze, Shavit & Tzafrir) in front of a list: in combining mode a thread publishes its
+ * InsertHead, Append, PopHead or Remove in a request slot, the thread which takes the combiner lock applies every
+ * published request to the list in one pass and hands the results back. The combined operations run one at a time,
+ * their CAS do not fail on each other and the repair paths stay idle, so a contended default list may take any number
+ * of removers in this mode. Combining is blocking, a waiting thread depends on the progress of the combiner.
+ * In kAdaptive mode an operation starts lock-free and the CAS failures of the list are counted in BackoffFailures(),
+ * so LIST should retry with CountingBackoff: once the operations of a thread average more than kCombineAbove / 16
+ * failures the list switches to combining, once the combiner passes average fewer than kLockFreeBelow / 16 requests
+ * it switches back. Lock-free stragglers and the combiner may overlap, both use the lock-free operations of LIST.
+ * LIST is LockFreeSiList or LockFreeBiList of any node type, everything but the four operations works as on LIST.
+ * SLOTS is the number of request slots, threads beyond it wait for a free slot.
+ */
+template<typename LIST, size_t SLOTS = 32>
+class LockFreeCombiningList : public LIST {
+public:
+    using NodePtr = typename LIST::NodePtr;
+    using Guard = typename LIST::Guard;
+
+    // the rates are scaled by 16, as the failure rate of AdaptiveBackoff
+    static const uint32_t kCombineAbove = 2 * 16;
+    static const uint32_t kLockFreeBelow = 2 * 16;
+
+    LockFreeCombiningList(CombiningMode mode = CombiningMode::kAdaptive) {
+        SetMode(mode);
+    }
+
+    /**
+     * Forces a mode or returns to the adaptive switching, kAdaptive keeps the current mode until the next switch.
+     */
+    void SetMode(CombiningMode mode) {
+        control_.mode.store(mode);
+        if (mode != CombiningMode::kAdaptive)
+            control_.combining.store(mode == CombiningMode::kCombining);
+        control_.batchRate.store(kLockFreeBelow * 4, memory_order_relaxed);
+    }
+
+    /**
+     * @return True if the operations currently go through the combiner.
+     */
+    bool IsCombining() const {
+        return control_.combining.load(memory_order_relaxed);
+    }
+
+    bool InsertHead(const NodePtr& node) {
+        Guard guard;
+        if (IsCombining())
+            return combine(kInsertHead, node).success;
+        uint64_t failures = BackoffFailures();
+        bool success = LIST::InsertHead(node);
+        countFailures(BackoffFailures() - failures);
+        return success;
+    }
+
+    bool Append(const NodePtr& node) {
+        Guard guard;
+        if (IsCombining())
+            return combine(kAppend, node).success;
+        uint64_t failures = BackoffFailures();
+        bool success = LIST::Append(node);
+        countFailures(BackoffFailures() - failures);
+        return success;
+    }
+
+    NodePtr PopHead() {
+        Guard guard;
+        if (IsCombining())
+            return combine(kPopHead, nullptr).node;
+        uint64_t failures = BackoffFailures();
+        NodePtr head = LIST::PopHead();
+        countFailures(BackoffFailures() - failures);
+        return head;
+    }
+
+    bool Remove(const NodePtr& node) {
+        Guard guard;
+        if (IsCombining())
+            return combine(kRemove, node).success;
+        uint64_t failures = BackoffFailures();
+        bool success = LIST::Remove(node);
+        countFailures(BackoffFailures() - failures);
+        return success;
+    }
+
+protected:
+    enum Operation { kInsertHead, kAppend, kPopHead, kRemove };
+    enum RequestState { kFree, kWriting, kPending, kDone };
+
+    struct Request {
+        atomic<int> state;
+        Operation operation;
+        NodePtr node;
+        bool success;
+
+        Request() : state(kFree), operation(kAppend), success(false) {}
+    };
+
+    struct Result {
+        NodePtr node;
+        bool success;
+    };
+
+    struct Control {
+        atomic<bool> locked;
+        atomic<bool> combining;
+        atomic<CombiningMode> mode;
+        atomic<uint32_t> batchRate;
+
+        Control() : locked(false), combining(false), mode(CombiningMode::kAdaptive), batchRate(0) {}
+    };
+
+    CacheLinePadded<Control> control_;
+    CacheLinePadded<Request> requests_[SLOTS];
+
+    /**
+     * Publishes a request and waits until a combiner, this thread or another one, applied it.
+     * @return The result of the request, the node is the result of PopHead.
+     */
+    Result combine(Operation operation, const NodePtr& node) {
+        Request& request = acquireRequest();
+        request.operation = operation;
+        request.node = node;
+        request.state.store(kPending, memory_order_release);
+        SpinYieldBackoff<> backoff; // yields to a preempted combiner
+        while (request.state.load(memory_order_acquire) != kDone) {
+            bool unlocked = false;
+            if (control_.locked.compare_exchange_strong(unlocked, true)) {
+                combinePass();
+                control_.locked.store(false, memory_order_release);
+            } else {
+                backoff.Wait();
+            }
+        }
+        Result result{std::move(request.node), request.success};
+        request.state.store(kFree, memory_order_release);
+        return result;
+    }
+
+    /**
+     * Applies every pending request, under the combiner lock.
+     */
+    void combinePass() {
+        uint32_t batch = 0;
+        for (Request& request : requests_) {
+            if (request.state.load(memory_order_acquire) != kPending)
+                continue;
+            switch (request.operation) {
+                case kInsertHead:
+                    request.success = LIST::InsertHead(request.node);
+                    break;
+                case kAppend:
+                    request.success = LIST::Append(request.node);
+                    break;
+                case kPopHead:
+                    request.node = LIST::PopHead();
+                    break;
+                case kRemove:
+                    request.success = LIST::Remove(request.node);
+                    break;
+            }
+            request.state.store(kDone, memory_order_release);
+            batch++;
+        }
+        uint32_t rate = control_.batchRate.load(memory_order_relaxed);
+        rate = rate - rate / 8 + min(batch, uint32_t(64)) * 16 / 8;
+        control_.batchRate.store(rate, memory_order_relaxed);
+        if (rate < kLockFreeBelow && control_.mode.load(memory_order_relaxed) == CombiningMode::kAdaptive)
+            control_.combining.store(false, memory_order_relaxed);
+    }
+
+    /**
+     * Claims a free request slot, starting from the slot of the thread.
+     */
+    Request& acquireRequest() {
+        static atomic<size_t> nextSlot(0);
+        static thread_local size_t home = nextSlot.fetch_add(1, memory_order_relaxed);
+        while (true) {
+            for (size_t i = 0; i < SLOTS; i++) {
+                Request& request = requests_[(home + i) % SLOTS];
+                int expected = kFree;
+                if (request.state.load(memory_order_relaxed) == kFree &&
+                    request.state.compare_exchange_strong(expected, kWriting))
+                    return request;
+            }
+            this_thread::yield();
+        }
+    }
+
+    /**
+     * Updates the failure rate of the thread with the CAS failures of the lock-free operation which just returned,
+     * and switches to combining once the rate is above kCombineAbove.
+     */
+    void countFailures(uint64_t failures) {
+        static thread_local uint32_t rate = 0;
+        rate = rate - rate / 8 + uint32_t(min(failures, uint64_t(64))) * 16 / 8;
+        if (rate > kCombineAbove && control_.mode.load(memory_order_relaxed) == CombiningMode::kAdaptive) {
+            control_.batchRate.store(kLockFreeBelow * 4, memory_order_relaxed);
+            control_.combining.store(true, memory_order_relaxed);
+        }
+    }
+};
+
+#endif //LOCKFREE_COMBINING_H
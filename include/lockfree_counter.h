@@ -0,0 +1,95 @@
+#ifndef LOCKFREE_COUNTER_H
+#define LOCKFREE_COUNTER_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "lockfree_util.h"
+
+using namespace std;
+
+/**
+ * A counting policy keeps the size of a list. Every policy provides:
+ *   kEnabled     false if the size is not tracked, Size() then returns -1.
+ *   Add(delta)   called once per linked or removed node.
+ *   Get()        the current size.
+ */
+
+/**
+ * Default policy: one 64-bit atomic counter, Size() is exact at any time.
+ */
+class ExactCounter {
+public:
+    static const bool kEnabled = true;
+
+    ExactCounter() : value_(0) {}
+
+    void Add(int64_t delta) {
+        value_.fetch_add(delta);
+    }
+
+    int64_t Get() const {
+        return value_.load();
+    }
+
+private:
+    atomic<int64_t> value_;
+};
+
+/**
+ * Per-thread counters on their own cache lines, Add() never touches a line shared with other threads
+ * unless more than kShards threads update the list. Get() sums the shards, so it is only exact
+ * while the list is not modified concurrently.
+ */
+class ShardedCounter {
+public:
+    static const bool kEnabled = true;
+    static const int kShards = 32;
+
+    ShardedCounter() {
+        for (Shard& shard : shards_)
+            shard.value.store(0, memory_order_relaxed);
+    }
+
+    void Add(int64_t delta) {
+        shards_[threadShard()].value.fetch_add(delta, memory_order_relaxed);
+    }
+
+    int64_t Get() const {
+        int64_t sum = 0;
+        for (const Shard& shard : shards_)
+            sum += shard.value.load(memory_order_relaxed);
+        return sum;
+    }
+
+private:
+    struct Shard {
+        atomic<int64_t> value;
+        char padding[kCacheLineSize - sizeof(atomic<int64_t>)];
+    };
+
+    char padding_[kCacheLineSize];
+    Shard shards_[kShards];
+
+    static int threadShard() {
+        static atomic<int> nextShard(0);
+        static thread_local int shard = nextShard.fetch_add(1, memory_order_relaxed) % kShards;
+        return shard;
+    }
+};
+
+/**
+ * No counter at all, for lists which never ask for their size.
+ */
+class NoCounter {
+public:
+    static const bool kEnabled = false;
+
+    void Add(int64_t) {}
+
+    int64_t Get() const {
+        return -1;
+    }
+};
+
+#endif //LOCKFREE_COUNTER_H
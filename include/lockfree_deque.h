@@ -0,0 +1,130 @@
+#ifndef LOCKFREE_DEQUE_H
+#define LOCKFREE_DEQUE_H
+
+#include "lockfree_bilist.h"
+
+/**
+ * Double-ended queue on the marked LockFreeBiList, every end operation works at its own end only:
+ * PushFront and PopFront CAS the link of the sentinel, PushBack CASes the link of the last node and PopBack marks
+ * the last node, then unlinks it from the predecessor its prev_ hint names. No operation walks from the other end
+ * unless a hint is stale, so with three nodes or more the two ends touch disjoint words, the size counter aside
+ * (see NoCounter and ShardedCounter).
+ * Every operation is linearizable: a push at its link CAS, PopBack at the mark of a node whose successor is nullptr,
+ * which is the last node then, PopFront at its last read of the sentinel link before the mark of the node it read.
+ * Unlike PopTail of the list, PopBack never removes a node which got a successor meanwhile.
+ * The middle inserts, the Emplace inserts and the single-node end operations of the list are hidden, Remove,
+ * PopHeadN, the chain inserts, the iterators and the rest work as on LockFreeBiList<T, RECLAIM, LockFreeMarkedBiNode>.
+ */
+template<typename T, typename RECLAIM = SharedPtrReclaim, typename COUNTER = ExactCounter,
+         typename LAYOUT = CompactLayout, typename BACKOFF = NoBackoff>
+class LockFreeDeque : public LockFreeBiList<T, RECLAIM, LockFreeMarkedBiNode, COUNTER, LAYOUT, BACKOFF> {
+    using Base = LockFreeBiList<T, RECLAIM, LockFreeMarkedBiNode, COUNTER, LAYOUT, BACKOFF>;
+
+public:
+    using NodeType = LockFreeMarkedBiNode<T, RECLAIM>;
+    using NodePtr = typename Base::NodePtr;
+    using Guard = typename RECLAIM::Guard;
+
+    /**
+     * Inserts a node before the first node.
+     */
+    void PushFront(const NodePtr& node) {
+        Base::InsertHead(node);
+    }
+
+    /**
+     * Inserts a node after the last node, the search for the last node starts from the tail_ hint.
+     */
+    void PushBack(const NodePtr& node) {
+        Base::Append(node);
+    }
+
+    /**
+     * @return The removed first node, nullptr if the deque is empty.
+     */
+    NodePtr PopFront() {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr first = this->nextOf(this->sentinel_);
+            if (first == nullptr)
+                return nullptr;
+            auto next = first->next_.get();
+            NodePtr nextNode = RECLAIM::template Cast<NodeType>(next.first);
+            if (next.second) {
+                // removed by another thread, help unlinking it
+                this->sentinel_->CompareAndSetNext(first, nextNode);
+                continue;
+            }
+            if (first->Delete(nextNode)) {
+                this->size_.Add(-1);
+                unlink(first, nextNode, this->sentinel_);
+                return first;
+            }
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * @return The removed last node, nullptr if the deque is empty.
+     */
+    NodePtr PopBack() {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr last = backNode();
+            if (last == this->sentinel_)
+                return nullptr;
+            // fails if the node got a successor or was removed meanwhile
+            if (last->Delete(nullptr)) {
+                this->size_.Add(-1);
+                unlink(last, nullptr, last->Prev());
+                return last;
+            }
+            backoff.Wait();
+        }
+    }
+
+    bool Empty() const {
+        Guard guard;
+        return this->Head() == nullptr;
+    }
+
+protected:
+    /**
+     * Unlinks a node this thread marked, with one CAS on prevHint if it is still the predecessor,
+     * by the search from the sentinel otherwise.
+     */
+    void unlink(const NodePtr& node, const NodePtr& nextNode, NodePtr prevHint) {
+        NodePtr prevNode = prevHint;
+        if (prevNode == nullptr || prevNode->isDeleted() || !prevNode->CompareAndSetNext(node, nextNode))
+            this->locate(node, prevNode, this->sentinel_);
+        if (nextNode == nullptr)
+            this->tail_.CompareAndSet(node, prevNode);
+        else if (this->nextOf(prevNode) == nextNode)
+            nextNode->SetPrev(prevNode);
+    }
+
+    /**
+     * The last node, the sentinel if the deque is empty. A removed tail_ hint is replaced by its prev_ hint,
+     * so a stale hint costs a step back instead of a walk from the sentinel.
+     */
+    NodePtr backNode() const {
+        NodePtr hint = this->tail_.Load();
+        while (hint != nullptr && hint->isDeleted())
+            hint = hint->Prev();
+        return this->lastNode(hint);
+    }
+
+private:
+    using Base::InsertHead;
+    using Base::Append;
+    using Base::Insert;
+    using Base::Emplace;
+    using Base::EmplaceHead;
+    using Base::EmplaceBefore;
+    using Base::PopHead;
+    using Base::PopTail;
+};
+
+#endif //LOCKFREE_DEQUE_H
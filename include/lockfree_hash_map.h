@@ -0,0 +1,296 @@
+#ifndef LOCKFREE_HASH_MAP_H
+#define LOCKFREE_HASH_MAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "lockfree_counter.h"
+#include "lockfree_silist.h"
+
+/**
+ * Entry of the split-ordered list: order is the bit-reversed hash, odd for an item, even for a bucket sentinel.
+ */
+template<typename K, typename V>
+struct SplitOrderedEntry {
+    uint64_t order;
+    K key;
+    V value;
+
+    SplitOrderedEntry() : order(0), key(), value() {}
+
+    SplitOrderedEntry(uint64_t order, const K& key, const V& value) : order(order), key(key), value(value) {}
+
+    bool IsBucket() const {
+        return (order & 1) == 0;
+    }
+};
+
+/**
+ * Lock-free hash map on a split-ordered list (Shalev & Shavit).
+ * Every item and bucket sentinel lives in one LockFreeSiList of marked nodes sorted by bit-reversed hash,
+ * a bucket is a shortcut to its sentinel. Doubling the bucket count never moves an item: the new bucket's sentinel
+ * is inserted lazily, by the first operation on it, between the items of its parent bucket.
+ * The bucket array is a directory of segments allocated on first use, K and V must be default constructible
+ * for the sentinels. The load decides when the buckets double, so COUNTER must track the size.
+ */
+template<typename K, typename V, typename HASH = hash<K>, typename EQUAL = equal_to<K>, typename COUNTER = ExactCounter>
+class LockFreeHashMap {
+    static_assert(COUNTER::kEnabled, "the bucket count grows with the size, COUNTER must track it (not NoCounter)");
+
+public:
+    using EntryType = SplitOrderedEntry<K, V>;
+    using ListType = LockFreeSiList<EntryType, SharedPtrReclaim, LockFreeMarkedNode>;
+    using NodeType = LockFreeMarkedNode<EntryType>;
+    using NodePtr = typename ListType::NodePtr;
+
+    static const int kSegmentBits = 10;
+    static const size_t kSegmentSize = size_t(1) << kSegmentBits;
+    static const size_t kMaxBuckets = kSegmentSize * kSegmentSize;
+    static const int kLoadFactor = 2;
+
+    LockFreeHashMap() : bucketCount_(2) {
+        for (auto& segment : segments_)
+            segment.store(nullptr, memory_order_relaxed);
+        NodePtr first = make_shared<NodeType>(EntryType());
+        list_.InsertHead(first);
+        bucket(0).Store(first);
+    }
+
+    // The buckets are released first, then list_ unlinks its chain node by node, see ~LockFreeMarkedList
+    virtual ~LockFreeHashMap() {
+        for (auto& segment : segments_)
+            delete segment.load();
+    }
+
+    /**
+     * Inserts key with value.
+     * @return True if inserted, false if key exists already.
+     */
+    bool Insert(const K& key, const V& value) {
+        size_t hashValue = hash_(key);
+        NodePtr node = make_shared<NodeType>(EntryType(itemOrder(hashValue), key, value));
+        NodePtr start = bucketOf(hashValue);
+        while (true) {
+            NodePtr prevNode;
+            NodePtr nextNode;
+            if (seek(start, node->data_.order, &key, prevNode, nextNode))
+                return false;
+            node->SetNext(nextNode);
+            if (prevNode->CompareAndSetNext(nextNode, node))
+                break;
+        }
+        size_.Add(1);
+        grow();
+        return true;
+    }
+
+    /**
+     * Looks key up, only the first operation on a new bucket writes to the list, to link the bucket's sentinel.
+     * @return The node of key, its data_.value is the value; nullptr if key is not in the map.
+     */
+    NodePtr Find(const K& key) {
+        size_t hashValue = hash_(key);
+        uint64_t order = itemOrder(hashValue);
+        NodePtr node = bucketOf(hashValue);
+        while (node != nullptr) {
+            auto next = node->next_.get();
+            if (!next.second) {
+                if (node->data_.order > order)
+                    return nullptr;
+                if (node->data_.order == order && equal_(node->data_.key, key))
+                    return node;
+            }
+            node = SharedPtrReclaim::Cast<NodeType>(next.first);
+        }
+        return nullptr;
+    }
+
+    bool Contains(const K& key) {
+        return Find(key) != nullptr;
+    }
+
+    /**
+     * Removes key.
+     * @return The removed node, nullptr if key is not in the map or another thread removed it first.
+     */
+    NodePtr Erase(const K& key) {
+        size_t hashValue = hash_(key);
+        uint64_t order = itemOrder(hashValue);
+        NodePtr start = bucketOf(hashValue);
+        NodePtr prevNode;
+        NodePtr node;
+        while (true) {
+            if (!seek(start, order, &key, prevNode, node))
+                return nullptr;
+            auto next = node->next_.get();
+            if (next.second)
+                continue;
+            NodePtr nextNode = SharedPtrReclaim::Cast<NodeType>(next.first);
+            if (!node->Delete(nextNode))
+                continue;
+            size_.Add(-1);
+            if (!prevNode->CompareAndSetNext(node, nextNode))
+                seek(start, order, &key, prevNode, nextNode); // unlinks the marked node
+            return node;
+        }
+    }
+
+    /**
+     * @return The number of items.
+     */
+    int64_t Size() const {
+        return size_.Get();
+    }
+
+    size_t BucketCount() const {
+        return bucketCount_.load(memory_order_relaxed);
+    }
+
+    /**
+     * This function is used for testing only, it only works in thread-safe mode.
+     * Checks the split order of the backbone and the item count.
+     */
+    bool CheckConsistence(int64_t count = -1) {
+        int64_t items = 0;
+        NodePtr prevNode = nullptr;
+        for (NodePtr node = list_.Head(); node != nullptr; node = list_.GetNext(node)) {
+            if (prevNode != nullptr && prevNode->data_.order > node->data_.order) {
+                std::cout << "fatal: " << node.get() << " is out of split order" << endl;
+                return false;
+            }
+            if (!node->data_.IsBucket())
+                items++;
+            prevNode = node;
+        }
+        if (count != -1 && (size_.Get() != count || items != count)) {
+            cout << "count:" << count << "actualCount: " << size_.Get() << " linked: " << items << endl;
+            return false;
+        }
+        return list_.CheckConsistence();
+    }
+
+private:
+    struct Segment {
+        SharedPtrReclaim::Link<NodeType> buckets[kSegmentSize];
+    };
+
+    ListType list_;
+    atomic<Segment*> segments_[kSegmentSize];
+    atomic<size_t> bucketCount_;
+    COUNTER size_;
+    HASH hash_;
+    EQUAL equal_;
+
+    static uint64_t reverse(uint64_t value) {
+        value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+        value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+        value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        value = ((value >> 8) & 0x00FF00FF00FF00FFULL) | ((value & 0x00FF00FF00FF00FFULL) << 8);
+        value = ((value >> 16) & 0x0000FFFF0000FFFFULL) | ((value & 0x0000FFFF0000FFFFULL) << 16);
+        return (value >> 32) | (value << 32);
+    }
+
+    static uint64_t itemOrder(size_t hashValue) {
+        return reverse(uint64_t(hashValue) | (uint64_t(1) << 63));
+    }
+
+    static uint64_t bucketOrder(size_t index) {
+        return reverse(uint64_t(index));
+    }
+
+    SharedPtrReclaim::Link<NodeType>& bucket(size_t index) {
+        atomic<Segment*>& slot = segments_[index >> kSegmentBits];
+        Segment* segment = slot.load();
+        if (segment == nullptr) {
+            Segment* newSegment = new Segment();
+            if (slot.compare_exchange_strong(segment, newSegment))
+                segment = newSegment;
+            else
+                delete newSegment;
+        }
+        return segment->buckets[index & (kSegmentSize - 1)];
+    }
+
+    NodePtr bucketOf(size_t hashValue) {
+        size_t index = hashValue & (bucketCount_.load(memory_order_relaxed) - 1);
+        NodePtr start = bucket(index).Load();
+        if (start == nullptr)
+            start = initializeBucket(index);
+        return start;
+    }
+
+    // Links the sentinel of a bucket after the sentinel of its parent, the bucket without its highest bit
+    NodePtr initializeBucket(size_t index) {
+        size_t highestBit = 1;
+        while (highestBit <= index >> 1)
+            highestBit <<= 1;
+        size_t parent = index & ~highestBit;
+        NodePtr start = bucket(parent).Load();
+        if (start == nullptr)
+            start = initializeBucket(parent);
+
+        NodePtr sentinel = make_shared<NodeType>(EntryType(bucketOrder(index), K(), V()));
+        while (true) {
+            NodePtr prevNode;
+            NodePtr nextNode;
+            if (seek(start, sentinel->data_.order, nullptr, prevNode, nextNode)) {
+                sentinel = nextNode;
+                break;
+            }
+            sentinel->SetNext(nextNode);
+            if (prevNode->CompareAndSetNext(nextNode, sentinel))
+                break;
+        }
+        bucket(index).CompareAndSet(nullptr, sentinel);
+        return bucket(index).Load();
+    }
+
+    // Doubles the bucket count once the average bucket holds more than kLoadFactor items
+    void grow() {
+        size_t count = bucketCount_.load(memory_order_relaxed);
+        int64_t size = size_.Get();
+        if (count < kMaxBuckets && size > int64_t(count) * kLoadFactor)
+            bucketCount_.compare_exchange_strong(count, count * 2);
+    }
+
+    /**
+     * Walks from a bucket sentinel to the node of order and key, unlinking marked nodes on the way.
+     * Items of equal order (colliding hashes) are compared by key, a nullptr key looks for a bucket sentinel.
+     *
+     * @param prevNode Set to the unmarked node before the position.
+     * @param nextNode Set to the matching node, or the first node after the position if there is none.
+     * @return True if the node is found.
+     */
+    bool seek(const NodePtr& start, uint64_t order, const K* key, NodePtr& prevNode, NodePtr& nextNode) {
+        prevNode = start;
+        NodePtr node = prevNode->Next();
+        while (node != nullptr) {
+            auto next = node->next_.get();
+            NodePtr successor = SharedPtrReclaim::Cast<NodeType>(next.first);
+            if (next.second) {
+                // bucket sentinels are never removed, restart from start if prevNode is removed meanwhile
+                if (prevNode->CompareAndSetNext(node, successor)) {
+                    node = successor;
+                } else {
+                    if (prevNode->isDeleted())
+                        prevNode = start;
+                    node = prevNode->Next();
+                }
+                continue;
+            }
+            if (node->data_.order > order)
+                break;
+            if (node->data_.order == order && (key == nullptr || equal_(node->data_.key, *key))) {
+                nextNode = node;
+                return true;
+            }
+            prevNode = node;
+            node = successor;
+        }
+        nextNode = node;
+        return false;
+    }
+};
+
+#endif //LOCKFREE_HASH_MAP_H
@@ -0,0 +1,134 @@
+#ifndef LOCKFREE_HOOK_H
+#define LOCKFREE_HOOK_H
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "lockfree_reclaim.h"
+#include "lockfree_unlink.h"
+
+using namespace std;
+
+/**
+ * Intrusive links of the default deletion scheme: a type deriving from LockFreeHook<OWNER, RECLAIM> (or
+ * LockFreeBiHook for LockFreeBiList) is the node of its list itself, so the list links the objects directly
+ * and allocates nothing per insert. Select it through the node switch of the lists:
+ *   struct Order : LockFreeHook<Order> { ... };
+ *   LockFreeSiList<Order, SharedPtrReclaim, LockFreeIntrusiveNode> orders;
+ *   orders.Append(make_shared<Order>(...));
+ * The objects are created by the caller: shared_ptr for SharedPtrReclaim, new for the policies owning the nodes,
+ * which delete the removed objects. An object is linked into one list at a time, copying it does not copy its links.
+ */
+template<typename OWNER, typename RECLAIM = SharedPtrReclaim>
+struct LockFreeHook {
+    using NodePtr = typename RECLAIM::template Ptr<OWNER>;
+
+    typename RECLAIM::template Link<OWNER> next_;
+
+    LockFreeHook() {}
+
+    LockFreeHook(const LockFreeHook&) {}
+
+    LockFreeHook& operator=(const LockFreeHook&) {
+        return *this;
+    }
+
+    NodePtr Next() {
+        NodePtr nextNode = next_.Load();
+        if (nextNode == dummyNode || isUnlinkNote(nextNode.get()))
+            return nullptr;
+        return nextNode;
+    }
+
+    // The next node for prefetching only, it may be stale, the sentinel, an unlink note or nullptr
+    const void* NextHint() const {
+        return next_.Hint();
+    }
+
+    void SetNext(const NodePtr& node) {
+        next_.Store(node);
+    }
+
+    bool isDeleted() {
+        const void* nextNode = next_.Peek();
+        return nextNode == dummyNode.get() || isUnlinkNote(nextNode);
+    }
+
+    bool Delete(const NodePtr& oldNext) {
+        return next_.CompareAndSet(oldNext, dummyNode);
+    }
+
+    bool CompareAndSetNext(const NodePtr& oldNext, const NodePtr& newNext) {
+        return next_.CompareAndSet(oldNext, newNext);
+    }
+
+    // The next_ a list links to remove the node, the tagged address of a note keeping its successor (lockfree_unlink.h)
+    static NodePtr Marker(const void* note) {
+        return RECLAIM::template Unmanaged<OWNER>(TagUnlinkNote<OWNER>(note));
+    }
+
+protected:
+    static const NodePtr dummyNode;
+
+    // the deletion sentinel is only compared by address, it is raw storage as OWNER may have no default constructor
+    static OWNER* sentinel() {
+        static typename aligned_storage<sizeof(OWNER), alignof(OWNER)>::type storage;
+        return reinterpret_cast<OWNER*>(&storage);
+    }
+};
+
+template<typename OWNER, typename RECLAIM>
+const typename LockFreeHook<OWNER, RECLAIM>::NodePtr LockFreeHook<OWNER, RECLAIM>::dummyNode =
+    RECLAIM::template Unmanaged<OWNER>(LockFreeHook<OWNER, RECLAIM>::sentinel());
+
+/**
+ * Intrusive links of LockFreeBiList, see LockFreeHook.
+ */
+template<typename OWNER, typename RECLAIM = SharedPtrReclaim>
+struct LockFreeBiHook : LockFreeHook<OWNER, RECLAIM> {
+    using BiNodePtr = typename RECLAIM::template Ptr<OWNER>;
+
+    typename RECLAIM::template Link<OWNER> prev_;
+
+    LockFreeBiHook() {}
+
+    LockFreeBiHook(const LockFreeBiHook&) : LockFreeHook<OWNER, RECLAIM>() {}
+
+    LockFreeBiHook& operator=(const LockFreeBiHook&) {
+        return *this;
+    }
+
+    // Retrieve the previous node
+    BiNodePtr Prev() {
+        return prev_.Load();
+    }
+
+    // The previous node for prefetching only, it may be stale or nullptr
+    const void* PrevHint() const {
+        return prev_.Hint();
+    }
+
+    void SetPrev(const BiNodePtr& node) {
+        prev_.Store(node);
+    }
+
+    bool CompareAndSetPrev(const BiNodePtr& oldPrev, const BiNodePtr& newPrev) {
+        return prev_.CompareAndSet(oldPrev, newPrev);
+    }
+};
+
+/**
+ * The node switch of the lists for hooked types: the node of T is T itself.
+ */
+template<typename T, typename RECLAIM>
+struct LockFreeHookedType {
+    static_assert(is_base_of<LockFreeHook<T, RECLAIM>, T>::value,
+                  "an intrusive node derives from LockFreeHook<T, RECLAIM> or LockFreeBiHook<T, RECLAIM>");
+    using type = T;
+};
+
+template<typename T, typename RECLAIM>
+using LockFreeIntrusiveNode = typename LockFreeHookedType<T, RECLAIM>::type;
+
+#endif //LOCKFREE_HOOK_H
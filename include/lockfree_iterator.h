@@ -0,0 +1,100 @@
+#ifndef LOCKFREE_ITERATOR_H
+#define LOCKFREE_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "lockfree_util.h"
+
+/**
+ * A weakly consistent forward iterator over a lock-free list, REVERSE walks a bidirectional list backward.
+ * Every step goes through GetNext (GetPrev), so deleted nodes are skipped and a node inserted or removed
+ * concurrently may or may not be visited, but no node is visited twice by one scan.
+ * If the current node is removed meanwhile, the step restarts from the node visited before it. When both are
+ * removed under the default deletion scheme, whose deleted nodes lose their successor, the scan ends early.
+ * Each step prefetches the node after the new current one, if the reclamation policy links raw pointers.
+ * Callers of EpochReclaim lists hold a Guard around the whole scan.
+ */
+template<typename LIST, bool REVERSE = false>
+class LockFreeListIterator {
+public:
+    using NodeType = typename LIST::NodeType;
+    using NodePtr = typename LIST::NodePtr;
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = NodeType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = NodeType*;
+    using reference = NodeType&;
+
+    LockFreeListIterator() : list_(nullptr) {}
+
+    LockFreeListIterator(LIST* list, const NodePtr& node) : list_(list), node_(node) {
+        prefetch(std::integral_constant<bool, REVERSE>());
+    }
+
+    reference operator*() const {
+        return *node_;
+    }
+
+    pointer operator->() const {
+        return node_.get();
+    }
+
+    // The current node as the list's own handle, e.g. to pass it to Remove or Insert
+    const NodePtr& Node() const {
+        return node_;
+    }
+
+    LockFreeListIterator& operator++() {
+        NodePtr nextNode = step(node_, std::integral_constant<bool, REVERSE>());
+        // a removed node may have lost its link, only then restart from the node visited before it
+        if (nextNode == nullptr && visited_ != nullptr && node_->isDeleted() && !visited_->isDeleted())
+            nextNode = step(visited_, std::integral_constant<bool, REVERSE>());
+        visited_ = std::move(node_);
+        node_ = std::move(nextNode);
+        prefetch(std::integral_constant<bool, REVERSE>());
+        return *this;
+    }
+
+    LockFreeListIterator operator++(int) {
+        LockFreeListIterator it = *this;
+        ++(*this);
+        return it;
+    }
+
+    bool operator==(const LockFreeListIterator& other) const {
+        return node_.get() == other.node_.get();
+    }
+
+    bool operator!=(const LockFreeListIterator& other) const {
+        return node_.get() != other.node_.get();
+    }
+
+private:
+    LIST* list_;
+    NodePtr node_;
+    NodePtr visited_;  // the node visited before node_, the restart point if node_ is removed
+
+    NodePtr step(const NodePtr& node, std::false_type) {
+        return list_->GetNext(node);
+    }
+
+    NodePtr step(const NodePtr& node, std::true_type) {
+        return list_->GetPrev(node);
+    }
+
+    void prefetch(std::false_type) const {
+        if (node_ != nullptr)
+            Prefetch(node_->NextHint());
+    }
+
+    void prefetch(std::true_type) const {
+        if (node_ != nullptr)
+            Prefetch(node_->PrevHint());
+    }
+};
+
+#endif //LOCKFREE_ITERATOR_H
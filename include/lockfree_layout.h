@@ -0,0 +1,78 @@
+#ifndef LOCKFREE_LAYOUT_H
+#define LOCKFREE_LAYOUT_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "lockfree_reclaim.h"
+#include "lockfree_util.h"
+
+using namespace std;
+
+/**
+ * A layout policy places the control words of a list: head_ (the sentinel of the marked lists), tail_ and size_.
+ * Slot<X> is the type of one control word of type X.
+ */
+
+/**
+ * Default policy: the control words are packed, the smallest list.
+ */
+struct CompactLayout {
+    template<typename X>
+    using Slot = X;
+};
+
+struct CacheLinePad {
+    char padding_[kCacheLineSize];
+};
+
+/**
+ * X between two cache lines of padding, so nothing else shares a cache line with it whatever the address of
+ * the enclosing object. Padding instead of alignas: before C++17 new ignores alignments above alignof(max_align_t).
+ */
+template<typename X>
+struct CacheLinePadded : CacheLinePad, X {
+    char trailingPadding_[kCacheLineSize];
+};
+
+/**
+ * Every control word on cache lines of its own, threads working at the head and threads working at the tail
+ * do not invalidate each other's lines, and the size counter invalidates neither of them.
+ * Costs about 6 cache lines per list.
+ */
+struct PaddedLayout {
+    template<typename X>
+    using Slot = CacheLinePadded<X>;
+};
+
+/**
+ * Allocation policy wrapper of a reclamation policy: every node starts a cache line and its size is rounded up
+ * to whole cache lines, so a hot node never shares a line with another node or an unrelated heap object.
+ * Nodes are created with CacheAlignedReclaim<RECLAIM>::Make<N>(args...), see PooledReclaim in lockfree_pool.h
+ * for the same guarantee from a per-thread pool.
+ */
+template<typename RECLAIM>
+struct CacheAlignedReclaim : RECLAIM {
+    static void* Allocate(size_t size) {
+        void* address = nullptr;
+        size_t lines = (size + kCacheLineSize - 1) / kCacheLineSize;
+        if (posix_memalign(&address, kCacheLineSize, lines * kCacheLineSize) != 0)
+            throw bad_alloc();
+        return address;
+    }
+
+    static void Deallocate(void* address, size_t) {
+        free(address);
+    }
+
+    template<typename N, typename... ARGS>
+    static typename RECLAIM::template Ptr<N> Make(ARGS&&... args) {
+        return MakeNode<CacheAlignedReclaim, N>(integral_constant<bool, RECLAIM::kOwnsNodes>(),
+                                                std::forward<ARGS>(args)...);
+    }
+};
+
+#endif //LOCKFREE_LAYOUT_H
@@ -4,17 +4,60 @@
 #include <memory>
 #include <functional>
 #include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "lockfree_reclaim.h"
+#include "lockfree_backoff.h"
+#include "lockfree_counter.h"
+#include "lockfree_iterator.h"
+#include "lockfree_layout.h"
+#include "lockfree_read_guard.h"
+#include "lockfree_stats.h"
+#include "lockfree_unlink.h"
 
-template<typename NODE>
+/**
+ * RECLAIM is the memory reclamation policy of the nodes, see lockfree_reclaim.h.
+ * SharedPtrReclaim keeps the nodes in shared_ptr, HazardPointerReclaim (hazard_pointer.h) and
+ * EpochReclaim (epoch_reclaim.h) link raw pointers and let the list own the nodes.
+ * Every public operation holds a RECLAIM::Guard, callers of EpochReclaim lists hold their own Guard
+ * as long as they use the returned nodes.
+ * COUNTER keeps Size(), see lockfree_counter.h.
+ * LAYOUT places head_, tail_ and size_, PaddedLayout keeps them on separate cache lines (see lockfree_layout.h).
+ * BACKOFF paces the retries after a failed CAS, see lockfree_backoff.h.
+ * STATS counts the failed CAS, retries, repairs and walks of the list, see lockfree_stats.h.
+ * DERIVED is the list type deriving from it (LockFreeSiList or LockFreeBiList), the linking hooks are called
+ * on it directly, so single or bidirectional linking is resolved at compile time and inlined into the hot loops.
+ */
+template<typename NODE, typename RECLAIM = SharedPtrReclaim, typename COUNTER = ExactCounter,
+         typename LAYOUT = CompactLayout, typename BACKOFF = NoBackoff, typename STATS = NoStats,
+         typename DERIVED = void>
 class LockFreeList {
 public:
+    using NodeType = NODE;
+    using Self = typename conditional<is_void<DERIVED>::value, LockFreeList, DERIVED>::type;
+    using NodePtr = typename RECLAIM::template Ptr<NODE>;
+    using Guard = typename RECLAIM::Guard;
+    using iterator = LockFreeListIterator<LockFreeList>;
+    using ReadGuard = LockFreeReadGuard<LockFreeList, RECLAIM>;
+
     LockFreeList() {
         // head_.store(nullptr);
         // tail_.store(nullptr);
-        size_.store(0);
     }
 
-    virtual ~LockFreeList() = default;
+    virtual ~LockFreeList() {
+        if (!RECLAIM::kOwnsNodes)
+            return;
+        NodePtr node = head_.Load();
+        while (node != nullptr) {
+            NodePtr nextNode = nextOf(node);
+            RECLAIM::Destroy(node);
+            node = nextNode;
+        }
+    }
 
     /**
      * Inserts a new node at the head of the list.
@@ -26,8 +69,8 @@ public:
      * @param forceSuccess To grant the insertion successfully.
      * @return True if the insertion is successful, false otherwise.
      */
-    bool InsertHead(shared_ptr<NODE> node, bool forceSuccess=true) {
-        return Insert(node, Head(), forceSuccess);
+    bool InsertHead(const NodePtr& node, bool forceSuccess=true) {
+        return InsertHeadChain(node, node, 1, forceSuccess);
     }
 
     /**
@@ -40,11 +83,65 @@ public:
      * @param forceSuccess To grant the insertion successfully.
      * @return True if the insertion is successful, false otherwise.
      */
-    bool Append(shared_ptr<NODE> node, bool forceSuccess=true) {
+    bool Append(const NodePtr& node, bool forceSuccess=true) {
+        Guard guard;
+        BACKOFF backoff;
+        while(true) {
+            NodePtr prevNode = lastNode(Tail());
+            bool result = InsertBetween(node, prevNode, nullptr);
+            if (!forceSuccess || result)
+                return result;
+            stats_.Count(ListEvent::kAppendRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Inserts a privately built chain of nodes at the head of the list with one link CAS.
+     * The chain is linked from first to last with SetNext by the caller, the list wires the prev_ of
+     * bidirectional nodes before the chain is published and adds count to the size once.
+     *
+     * @param first The first node of the chain.
+     * @param last The last node of the chain, first for a single node.
+     * @param count The number of nodes from first to last.
+     * @param forceSuccess To grant the insertion successfully.
+     * @return True if the insertion is successful, false otherwise.
+     */
+    bool InsertHeadChain(const NodePtr& first, const NodePtr& last, int64_t count, bool forceSuccess=true) {
+        Guard guard;
+        linkChainPrev(first, last);
+        BACKOFF backoff;
+        while(true) {
+            // a head being removed is linked behind the chain, it is unlinked from there
+            bool result = insertChainBetween(first, last, count, nullptr, Head());
+            if (!forceSuccess || result)
+                return result;
+            stats_.Count(ListEvent::kInsertRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Appends a privately built chain of nodes at the tail of the list with one link CAS and one tail update,
+     * see InsertHeadChain for the chain.
+     *
+     * @param first The first node of the chain.
+     * @param last The last node of the chain, first for a single node.
+     * @param count The number of nodes from first to last.
+     * @param forceSuccess To grant the insertion successfully.
+     * @return True if the insertion is successful, false otherwise.
+     */
+    bool AppendChain(const NodePtr& first, const NodePtr& last, int64_t count, bool forceSuccess=true) {
+        Guard guard;
+        linkChainPrev(first, last);
+        BACKOFF backoff;
         while(true) {
-            bool result = InsertBetween(node, Tail(), nullptr);
+            NodePtr prevNode = lastNode(Tail());
+            bool result = insertChainBetween(first, last, count, prevNode, nullptr);
             if (!forceSuccess || result)
                 return result;
+            stats_.Count(ListEvent::kAppendRetry);
+            backoff.Wait();
         }
     }
 
@@ -55,78 +152,273 @@ public:
  * if you need to grant original order, set forceSuccess as false and keep the order before call this function.
  *
  * @param newNode The new node to be inserted.
- * @param targetNode The target node before which the new node should be inserted.
+ * @param targetNode The target node before which the new node should be inserted, the node is appended if it is
+ * nullptr and goes where the target was if the target is removed meanwhile, see locateInsert.
  * @param forceSuccess To grant the insertion successfully.
  * @param interFunc The test function to be called during the insertion process to modify the list.
  * @return True if the insertion is successful, false otherwise.
  */
 #ifdef TEST_MIDDLE_CHANGE
-    using InterferenceFunc = function<void(int step, shared_ptr<NODE> curentNode, shared_ptr<NODE> prevNode, shared_ptr<NODE> nextNode)>;
+    using InterferenceFunc = function<void(int step, NodePtr curentNode, NodePtr prevNode, NodePtr nextNode)>;
 
-    bool Insert(shared_ptr<NODE> node, shared_ptr<NODE> targetNode, bool forceSuccess=true, InterferenceFunc interFunc=nullptr) {
+    bool Insert(const NodePtr& node, const NodePtr& targetNode, bool forceSuccess=true, InterferenceFunc interFunc=nullptr) {
         int count = 0;
 #else
-    bool Insert(shared_ptr<NODE> node, shared_ptr<NODE> targetNode, bool forceSuccess=true) {
+    bool Insert(const NodePtr& node, const NodePtr& targetNode, bool forceSuccess=true) {
 #endif
+        Guard guard;
+        BACKOFF backoff;
+        NodePtr prevNode;
         while(true) {
-            shared_ptr<NODE> nextNode = targetNode;
-            shared_ptr<NODE> prevNode;
-            if (nullptr != nextNode) {
-                if (nextNode->isDeleted())
-                    nextNode = getValidNext(nextNode);
-                prevNode = getValidPrev(nextNode);
-            }
-
-            bool result;
+            NodePtr nextNode;
+            bool result = false;
+            if (locateInsert(targetNode, nullptr, prevNode, nextNode)) {
 #ifdef TEST_MIDDLE_CHANGE
-            if (0 == count++)
-                result = InsertBetween(node, prevNode, nextNode, interFunc);
-            else
-                result = InsertBetween(node, prevNode, nextNode);
+                if (0 == count++)
+                    result = InsertBetween(node, prevNode, nextNode, interFunc);
+                else
+                    result = InsertBetween(node, prevNode, nextNode);
 #else
-            result = InsertBetween(node, prevNode, nextNode);
+                result = InsertBetween(node, prevNode, nextNode);
 #endif
+            }
             if (!forceSuccess || result)
                 return result;
+            stats_.Count(ListEvent::kInsertRetry);
+            backoff.Wait();
         }
     }
 
-    shared_ptr<NODE> Head() const {
-        return atomic_load(&head_);
+    /**
+     * Inserts a new node before a target node with the caller's guess of the target's predecessor,
+     * a valid hint saves the search of the predecessor, a stale one falls back to the search.
+     *
+     * @param node The new node to be inserted.
+     * @param targetNode The target node before which the new node should be inserted.
+     * @param prevHint The node expected right before targetNode, nullptr if unknown.
+     * @param forceSuccess To grant the insertion successfully.
+     * @return True if the insertion is successful, false otherwise.
+     */
+    bool Insert(const NodePtr& node, const NodePtr& targetNode, const NodePtr& prevHint, bool forceSuccess=true) {
+        Guard guard;
+        BACKOFF backoff;
+        NodePtr prevNode;
+        while(true) {
+            NodePtr nextNode;
+            bool result = locateInsert(targetNode, prevHint, prevNode, nextNode) && InsertBetween(node, prevNode, nextNode);
+            if (!forceSuccess || result)
+                return result;
+            stats_.Count(ListEvent::kInsertRetry);
+            backoff.Wait();
+        }
     }
 
-    shared_ptr<NODE> Tail() const {
-        return atomic_load(&tail_);
+    /**
+     * Creates a node with RECLAIM::Make, its data_ constructed in place from args, and appends it.
+     * With SharedPtrReclaim the node and its control block are one allocation.
+     *
+     * @param args The arguments of a constructor of the data.
+     * @return The new node, callers of EpochReclaim lists hold a Guard as long as they use it.
+     */
+    template<typename... ARGS>
+    NodePtr Emplace(ARGS&&... args) {
+        NodePtr node = RECLAIM::template Make<NODE>(std::forward<ARGS>(args)...);
+        Append(node);
+        return node;
     }
 
-    int Size() const {
-        return size_.load();
+    /**
+     * Creates a node as Emplace does and inserts it at the head of the list.
+     */
+    template<typename... ARGS>
+    NodePtr EmplaceHead(ARGS&&... args) {
+        NodePtr node = RECLAIM::template Make<NODE>(std::forward<ARGS>(args)...);
+        InsertHead(node);
+        return node;
     }
 
-    shared_ptr<NODE> GetNext(shared_ptr<NODE> node) {
+    /**
+     * Creates a node as Emplace does and inserts it before targetNode, see Insert.
+     */
+    template<typename... ARGS>
+    NodePtr EmplaceBefore(const NodePtr& targetNode, ARGS&&... args) {
+        NodePtr node = RECLAIM::template Make<NODE>(std::forward<ARGS>(args)...);
+        Insert(node, targetNode);
+        return node;
+    }
+
+    NodePtr Head() const {
+        Guard guard;
+        return head_.Load();
+    }
+
+    NodePtr Tail() const {
+        Guard guard;
+        return tail_.Load();
+    }
+
+    /**
+     * @return The number of nodes, -1 if COUNTER does not track the size.
+     */
+    int64_t Size() const {
+        return size_.Get();
+    }
+
+    /**
+     * @return The contention counts so far, all zeros if STATS does not count, see lockfree_stats.h.
+     */
+    ListStats Stats() const {
+        return stats_.Snapshot();
+    }
+
+    /**
+     * Weakly consistent iteration from the head, see lockfree_iterator.h.
+     */
+    iterator begin() {
+        return iterator(this, Head());
+    }
+
+    iterator end() {
+        return iterator(this, nullptr);
+    }
+
+    NodePtr GetNext(const NodePtr& node) {
         if (nullptr == node)
             return nullptr;
+        Guard guard;
         return getValidNext(node);
     }
 
-    shared_ptr<NODE> GetPrev(shared_ptr<NODE> node) {
+    NodePtr GetPrev(const NodePtr& node) {
         if (nullptr == node)
             return nullptr;
-        return getValidPrev(node);
+        Guard guard;
+        return getValidPrev(node, nullptr);
     }
 
-    shared_ptr<NODE> PopHead(void) {
-        shared_ptr<NODE> head = Head();
-        if (nullptr == head || !deleteNode(head))
-            return nullptr;
-        return head;
+    /**
+     * Removes the head. A head removed by another thread meanwhile is unlinked and the new head is tried, so it
+     * returns nullptr only if it finds the list empty.
+     */
+    NodePtr PopHead(void) {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr head = Head();
+            if (nullptr == head || Remove(head, false))
+                return head;
+            if (head->isDeleted())
+                helpUnlink(nullptr, head);
+            stats_.Count(ListEvent::kRemoveRetry);
+            backoff.Wait();
+        }
     }
 
-    shared_ptr<NODE> PopTail(void) {
-        shared_ptr<NODE> tail = Tail();
-        if (nullptr == tail || !deleteNode(tail))
-            return nullptr;
-        return tail;
+    /**
+     * Removes the last node, searched forward from the tail_ hint, as PopHead removes the head.
+     */
+    NodePtr PopTail(void) {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr tail = lastNode(Tail());
+            if (nullptr == tail || Remove(tail, false))
+                return tail;
+            stats_.Count(ListEvent::kRemoveRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Removes the head as PopHead() does and moves its data_ out, e.g. for move-only data.
+     * The removed node keeps a moved-from data_, which another thread still holding the node (an iterator,
+     * a ReadGuard, ...) must not read.
+     *
+     * @param value Receives the data of the removed node.
+     * @return True if a node was removed, false if the list is empty.
+     */
+    template<typename VALUE>
+    bool PopHead(VALUE& value) {
+        Guard guard;
+        NodePtr head = PopHead();
+        if (nullptr == head)
+            return false;
+        value = std::move(head->data_);
+        return true;
+    }
+
+    /**
+     * Removes the tail as PopTail() does and moves its data_ out, see PopHead(value).
+     */
+    template<typename VALUE>
+    bool PopTail(VALUE& value) {
+        Guard guard;
+        NodePtr tail = PopTail();
+        if (nullptr == tail)
+            return false;
+        value = std::move(tail->data_);
+        return true;
+    }
+
+    /**
+     * Removes up to n nodes from the head in runs: every node is claimed by a CAS of its own, as PopHead does, then
+     * a run of up to LockFreeUnlinkNotes::kRunLength claimed nodes is unlinked as one segment with one link update.
+     * The size is updated once.
+     *
+     * @param n The maximum number of nodes to remove.
+     * @param out A vector or deque, receives the removed nodes in list order.
+     * @return The number of nodes removed, less than n only if the list was found empty.
+     */
+    template<typename OUT>
+    size_t PopHeadN(size_t n, OUT& out) {
+        Guard guard;
+        size_t total = 0;
+        while (total < n) {
+            NodePtr first = Head();
+            NodePtr node = first;
+            size_t count = 0;
+            while (node != nullptr && count < n - total && count < Notes::kRunLength) {
+                NodePtr nextNode;
+                if (claim(node, count, nextNode)) {
+                    out.push_back(node);
+                    node = nextNode;
+                    count++;
+                } else if (node->isDeleted()) {
+                    break; // removed by another thread, the claimed run ends before it
+                }
+                // else a node was linked right behind it, claim it again with the new successor
+            }
+            if (count == 0) {
+                if (first == nullptr)
+                    break;
+                helpUnlink(nullptr, first); // the head was removed by another thread
+                continue;
+            }
+
+            // the run is unlinked as Remove unlinks a single node
+            unlinkRun(first, count, nullptr);
+            for (size_t i = out.size() - count; i < out.size(); i++) {
+                self().setPrev(out[i], nullptr);
+                RECLAIM::Retire(out[i]);
+            }
+            total += count;
+        }
+        this->size_.Add(-int64_t(total));
+        return total;
+    }
+
+    /**
+     * Drains the list with PopHeadN batches until Head() finds it empty, an empty batch while a removal by another
+     * thread is still being unlinked does not end it. It is a batched drain, not an O(1) detach: every node is still
+     * claimed by a CAS of its own, so the cost is O(n), and nodes appended meanwhile are drained too.
+     *
+     * @return The removed nodes, in the order they were removed.
+     */
+    vector<NodePtr> DrainAll() {
+        vector<NodePtr> nodes;
+        while (Head() != nullptr)
+            PopHeadN(numeric_limits<size_t>::max(), nodes);
+        return nodes;
     }
 
     /**
@@ -134,42 +426,49 @@ public:
      * Continuously attempts to remove the node until successful.
      * NOTE: Set forceSuccess as true does not guarantee original order for sorted list,
      * if you need to grant original order, set forceSuccess as false and keep the order before call this function.
+     * The removed node is handed to RECLAIM::Retire, a handle still held by the caller keeps it readable.
+     *
+     * @param node The node to be removed.
+     * @param forceSuccess To grant the removal successfully.
+     * @return True if the removal is successful, false otherwise.
+     */
+    bool Remove(const NodePtr& node, bool forceSuccess=true) {
+        return Remove(node, nullptr, forceSuccess);
+    }
+
+    /**
+     * Removes a node with the caller's guess of its predecessor, e.g. the node visited right before it.
+     * A valid hint saves the search of the predecessor, a stale one falls back to the search.
      *
      * @param node The node to be removed.
+     * @param prevHint The node expected right before node, nullptr if unknown.
      * @param forceSuccess To grant the removal successfully.
      * @return True if the removal is successful, false otherwise.
      */
-    bool Remove(shared_ptr<NODE> node, bool forceSuccess=true) {
+    bool Remove(const NodePtr& node, const NodePtr& prevHint, bool forceSuccess=true) {
         if (node == nullptr || node->isDeleted()) {
             return false;
         }
+        Guard guard;
+        BACKOFF backoff;
         while(true) {
-            shared_ptr<NODE> nextNode = static_pointer_cast<NODE>(node->Next());
-
-            // mark as delete first
-            if (node->Delete(nextNode)) {
-                shared_ptr<NODE> prevNode = getValidPrev(node);
-                bool headOrTail = false;
-                if (node == Tail() || nextNode == nullptr) {
-                    headOrTail = updateTail(prevNode, node);
-                }
+            NodePtr nextNode;
 
-                nextNode = getValidNext(node);
-                if (node == Head() || prevNode == nullptr) {
-                    headOrTail = updateHead(nextNode, node);
-                }
-                if (!headOrTail && nullptr != prevNode || nullptr != nextNode) {
-                    deleteNodeBetween(node, prevNode, nextNode);
-                }
-                setPrev(node, nullptr);
+            // mark as delete first, the node stays linked until the link into it is swung over to nextNode
+            if (claim(node, 0, nextNode)) {
+                unlinkRun(node, 1, prevHint);
+                self().setPrev(node, nullptr);
 
-                this->size_.fetch_add(-1);
+                this->size_.Add(-1);
+                RECLAIM::Retire(node);
                 return true;
             }
-            if (nextNode == nullptr && node->isDeleted())
+            if (node->isDeleted())
                 return false;
             if (!forceSuccess)
                 return false;
+            stats_.Count(ListEvent::kRemoveRetry);
+            backoff.Wait();
         }
     }
 
@@ -185,19 +484,20 @@ public:
      * @param count The expected size of the list, if not provided, it is ignored.
      * @return True if the list is consistent, false otherwise.
      */
-    bool CheckConsistence(int count = -1) {
-        shared_ptr<NODE> tempNode = Head();
+    bool CheckConsistence(int64_t count = -1) {
+        Guard guard;
+        NodePtr tempNode = Head();
         int i = 0;
         while(tempNode != nullptr && tempNode != nullptr) {
             if (tempNode->isDeleted()) {
                 std::cout << "fatal: " << tempNode.get() << " is deleted" << endl;
                 return false;
             }
-            shared_ptr<NODE> nextNode = static_pointer_cast<NODE>(tempNode->Next());
+            NodePtr nextNode = nextOf(tempNode);
             if (nextNode != nullptr && !nextNode->isDeleted()) {
                 if (nextNode == nullptr)
                     return true;
-                if (isWrongConnection(tempNode, nextNode)) {
+                if (self().isWrongConnection(tempNode, nextNode)) {
                     return false;
                 }
             }
@@ -206,8 +506,8 @@ public:
             i++;
         }
 
-        if (count != -1 && this->size_.load() != count) {
-            cout << "count:" << count << "actualCount: " << this->size_.load() << endl;
+        if (COUNTER::kEnabled && count != -1 && this->size_.Get() != count) {
+            cout << "count:" << count << "actualCount: " << this->size_.Get() << endl;
             return false;
         }
         return true;
@@ -225,165 +525,349 @@ public:
  * @param interFunc The test function to be called during the insertion process to modify the list.
  * @return True if the insertion is successful, false otherwise.
  */
-    bool InsertBetween(shared_ptr<NODE> node, shared_ptr<NODE> prevNode, shared_ptr<NODE> nextNode, InterferenceFunc interFunc=nullptr) {
+    bool InsertBetween(const NodePtr& node, const NodePtr& prevNode, const NodePtr& nextNode, InterferenceFunc interFunc=nullptr) {
+        return insertChainBetween(node, node, 1, prevNode, nextNode, interFunc);
+    }
 #else
 protected:
-    bool InsertBetween(shared_ptr<NODE> node, shared_ptr<NODE> prevNode, shared_ptr<NODE> nextNode) {
+    bool InsertBetween(const NodePtr& node, const NodePtr& prevNode, const NodePtr& nextNode) {
+        return insertChainBetween(node, node, 1, prevNode, nextNode);
+    }
 #endif
-        if (prevNode == nullptr && nextNode == nullptr) {
-            node->SetNext(nullptr);
-            setPrev(node, nullptr);
-            atomic_store(&this->head_, node);
-            atomic_store(&this->tail_, node);
-            this->size_.fetch_add(1);
-            return true;
-        }
-        // insert in the middle
-        node->SetNext(nextNode);
-        setPrev(node, prevNode);
+
+protected:
+    /**
+     * Inserts the chain first..last of count nodes between prevNode and nextNode, a single node is first == last.
+     * The chain is published by one CAS of the link into nextNode, the next_ of prevNode or the head when prevNode
+     * is nullptr, the prev_ of nextNode and the tail follow. The chain itself is private to the caller until then.
+     */
+#ifdef TEST_MIDDLE_CHANGE
+    bool insertChainBetween(const NodePtr& first, const NodePtr& last, int64_t count, const NodePtr& prevNode,
+                            const NodePtr& nextNode, InterferenceFunc interFunc=nullptr) {
+#else
+    bool insertChainBetween(const NodePtr& first, const NodePtr& last, int64_t count, const NodePtr& prevNode,
+                            const NodePtr& nextNode) {
+#endif
+        last->SetNext(nextNode);
+        self().setPrev(first, prevNode);
 #ifdef TEST_MIDDLE_CHANGE
         if (interFunc)
-            interFunc(1, node, prevNode, nextNode);
+            interFunc(1, first, prevNode, nextNode);
 #endif
-        // Step2: Update the next pointer of previous node first, if failed, means concurrently changed by another thread,
-        // return failed and let the caller retry with updated prevNode or nextNode;
-        if (prevNode != nullptr && (!prevNode->isDeleted()) && !isNodeIn(node, prevNode, nextNode, false)) {
-            if (!updateNext(prevNode, node, nextNode))
-                return false;
-        } else if (prevNode == nullptr || (prevNode->isDeleted() && getPrev(prevNode) == nullptr))  {
-            // prevNode == nullptr, means insert from head
-            if (updateHead(node, nextNode))
+        // Step2: Update the link into nextNode, if failed, means concurrently changed by another thread (a removed
+        // prevNode has the sentinel as next_), return failed and let the caller retry with updated prevNode or nextNode;
+        if (prevNode == nullptr) {
+            if (!this->head_.CompareAndSet(nextNode, first)) {
+                stats_.Count(ListEvent::kHeadCasFailure);
                 return false;
+            }
+        } else if (!prevNode->CompareAndSetNext(nextNode, first)) {
+            stats_.Count(ListEvent::kNextCasFailure);
+            return false;
         }
-        this->size_.fetch_add(1);
+        this->size_.Add(count);
 
 #ifdef TEST_MIDDLE_CHANGE
         if (interFunc)
-            interFunc(2, node, prevNode, nextNode);
+            interFunc(2, last, prevNode, nextNode);
 #endif
 
-        // Step3: Update the prev pointer of next node
-        // Because the next pointer is already chained successfully, so here need to chain the pointer and fix consistance.
-        if (hasPrev() && nextNode != nullptr && (!nextNode->isDeleted()) && !isNodeIn(node, nextNode, prevNode, true)) {
-            updatePrev(nextNode, node, prevNode);
-        } else if (nextNode == nullptr || nextNode->Next() == nullptr) {
-            updateTail(node, prevNode);
-        }
+        // Step3: Update the prev pointer of next node, or the tail
+        if (nextNode == nullptr) {
+            // tail_ mostly still names prevNode, settleTail only checks the move then
+            tail_.CompareAndSet(prevNode, last);
+            settleTail();
+        } else if (settlePrev(nextNode, last))
+            stats_.Count(ListEvent::kFixInsert);
 
 #ifdef TEST_MIDDLE_CHANGE
         if (interFunc)
-            interFunc(3, node, prevNode, nextNode);
+            interFunc(3, last, prevNode, nextNode);
 #endif
-
-        bool breaked;
-        if (hasPrev())
-            breaked = ((prevNode != nullptr && prevNode->isDeleted()) || getPrev(node) != prevNode
-            || (nextNode != nullptr && nextNode->isDeleted()) || node->Next() != nextNode);
-        else
-            breaked = ((prevNode != nullptr && prevNode->isDeleted()) || (nextNode != nullptr && nextNode->isDeleted()) ||     node->Next() != nextNode);
-
-        if (!breaked)
-            return true;
-        if (nullptr != nextNode)
-            fixInsert(node, prevNode, nextNode);
         return true;
     }
 
 protected:
-    shared_ptr<NODE> head_;
-    shared_ptr<NODE> tail_;
-    atomic<int> size_;
-
-    virtual void setPrev(shared_ptr<NODE> node, shared_ptr<NODE> prevNode) {}
-    virtual shared_ptr<NODE> getPrev(shared_ptr<NODE> node) {return nullptr;}
-    virtual bool hasPrev() {return false;}
-    virtual void updatePrev(shared_ptr<NODE> node, shared_ptr<NODE> newNode, shared_ptr<NODE> prevNode) {}
-    virtual void fixPrev(shared_ptr<NODE> nextNode, shared_ptr<NODE> actualPrevNode, shared_ptr<NODE> actualNextNode) {}
-
-    virtual void deleteNodeBetween(shared_ptr<NODE> node, shared_ptr<NODE> prevNode, shared_ptr<NODE> nextNode) = 0;
-    virtual shared_ptr<NODE> getValidPrev(shared_ptr<NODE> node) = 0;
-    virtual bool isWrongConnection(shared_ptr<NODE> node, shared_ptr<NODE> nextNode) = 0;
-
-    shared_ptr<NODE> getValidNext(shared_ptr<NODE> node) {
-        shared_ptr<NODE>nextNode = static_pointer_cast<NODE>(node->Next());
+    using Notes = LockFreeUnlinkNotes<NODE, RECLAIM>;
+
+    typename LAYOUT::template Slot<typename RECLAIM::template Link<NODE>> head_;
+    typename LAYOUT::template Slot<typename RECLAIM::template Link<NODE>> tail_;
+    typename LAYOUT::template Slot<COUNTER> size_;
+    mutable STATS stats_;
+
+    // The linking hooks of a singly linked list, DERIVED hides the ones it changes.
+    // DERIVED provides isWrongConnection, which has no default.
+    static constexpr bool hasPrev() {return false;}
+    void setPrev(const NodePtr&, const NodePtr&) {}
+    NodePtr getPrev(const NodePtr&) {return nullptr;}
+    bool compareAndSetPrev(const NodePtr&, const NodePtr&, const NodePtr&) {return false;}
+
+    Self& self() {
+        return static_cast<Self&>(*this);
+    }
+
+    NodePtr nextOf(const NodePtr& node) const {
+        return RECLAIM::template Cast<NODE>(node->Next());
+    }
+
+    NodePtr getValidPrev(const NodePtr& node, const NodePtr& prevHint) {
+        NodePtr prevNode;
+        if (nullptr == node || !findPrev(node, prevHint, prevNode))
+            return nullptr;
+        return prevNode;
+    }
+
+    // The first node after node which is not removed, removed nodes linked after it are unlinked on the way
+    NodePtr getValidNext(const NodePtr& node) {
+        NodePtr nextNode = nextOf(node);
+        uint64_t steps = 0;
         while (nextNode != nullptr && nextNode->isDeleted()) {
-            nextNode = static_pointer_cast<NODE>(nextNode->Next());
+            helpUnlink(node, nextNode);
+            nextNode = nextOf(node);
+            steps++;
         }
+        stats_.Walk(ListWalk::kValidNext, steps);
         return nextNode;
     }
 
-    virtual bool updateHead(shared_ptr<NODE> node, shared_ptr<NODE> prevHead=nullptr) {
-        if (prevHead == nullptr)
-            prevHead = this->head_;
-        if (atomic_compare_exchange_weak(&this->head_, &prevHead, node) && nullptr != node)
-            setPrev(node, nullptr);
+    // True if prevNode is linked right before node now, nullptr is before the head
+    bool isPrevOf(const NodePtr& prevNode, const NodePtr& node) {
+        if (prevNode == nullptr)
+            return Head() == node;
+        return !prevNode->isDeleted() && prevNode->Next() == node;
     }
 
-    virtual bool updateTail(shared_ptr<NODE> node, shared_ptr<NODE> prevTail = nullptr) {
-        if (atomic_compare_exchange_weak(&tail_, &prevTail, node)) {
-            if (nullptr != node)
-                node->SetNext(nullptr);
+    /**
+     * Finds the node linked right before node: prevHint, the prev_ of a bidirectional node and then a search from the
+     * head. nullptr stands for the end of the list, its predecessor is the last node. The search unlinks the removed
+     * nodes it meets (helpUnlink) and starts over from the head if the node it stands on is removed.
+     *
+     * @return False if node is not linked, prevNode is nullptr then.
+     */
+    bool findPrev(const NodePtr& node, const NodePtr& prevHint, NodePtr& prevNode) {
+        if (node == nullptr) {
+            prevNode = lastNode(Tail());
             return true;
         }
-        return false;
+        if (prevHint != nullptr && isPrevOf(prevHint, node)) {
+            prevNode = prevHint;
+            stats_.Walk(ListWalk::kValidPrev, 0);
+            return true;
+        }
+        prevNode = self().getPrev(node);
+        if (isPrevOf(prevNode, node)) {
+            stats_.Walk(ListWalk::kValidPrev, 0);
+            return true;
+        }
+        uint64_t steps = 0;
+        bool found = false;
+        prevNode = nullptr;
+        while (true) {
+            NodePtr nextNode = prevNode == nullptr ? Head() : nextOf(prevNode);
+            if (nextNode == node) {
+                found = true;
+                break;
+            }
+            if (nextNode == nullptr) {
+                // nextOf is nullptr at the end of the list and at a removed node
+                if (prevNode == nullptr || !prevNode->isDeleted())
+                    break;
+                prevNode = nullptr;
+            } else if (nextNode->isDeleted()) {
+                helpUnlink(prevNode, nextNode);
+            } else {
+                prevNode = nextNode;
+            }
+            steps++;
+        }
+        stats_.Walk(ListWalk::kValidPrev, steps);
+        if (!found)
+            prevNode = nullptr;
+        return found;
     }
 
-    bool updateNext(shared_ptr<NODE> node, shared_ptr<NODE> newNode, shared_ptr<NODE> nextNode = nullptr) {
-        if (nextNode == nullptr)
-            nextNode = static_pointer_cast<NODE>(node->Next());
-        // avoid ABA
-        shared_ptr<NODE> nexOfNewNode = nullptr;
-        if (newNode != nullptr)
-            nexOfNewNode = static_pointer_cast<NODE>(newNode->Next());
-        if (node != newNode && nexOfNewNode != node)
-            return node->CompareAndSetNext(nextNode, newNode);
+    /**
+     * Finds where an Insert attempt links its node: between the predecessor of targetNode and targetNode, behind the
+     * last node for a nullptr target. Once the target is removed the node goes where the target was, behind the
+     * prevNode found for it by an earlier attempt, or at the head if there is none or it is removed too.
+     */
+    bool locateInsert(const NodePtr& targetNode, const NodePtr& prevHint, NodePtr& prevNode, NodePtr& nextNode) {
+        nextNode = targetNode;
+        if (nextNode == nullptr || !nextNode->isDeleted())
+            return findPrev(nextNode, prevHint, prevNode);
+        if (prevNode != nullptr && prevNode->isDeleted())
+            prevNode = nullptr;
+        nextNode = prevNode == nullptr ? Head() : nextOf(prevNode);
         return true;
     }
 
-    bool isNodeIn(shared_ptr<NODE> node, shared_ptr<NODE> startNode, shared_ptr<NODE> endNode, bool reverse) {
-        shared_ptr<NODE> checkNode = startNode;
-        bool nodeInChain = false;
-        while (checkNode != nullptr && checkNode != endNode) {
-            if (checkNode == node)
-                nodeInChain = true;
-            if (reverse && hasPrev())
-                checkNode = getPrev(checkNode);
-            else
-                checkNode = static_pointer_cast<NODE>(checkNode->Next());
+    // The last node, searched forward from prevNode, or from the head if prevNode is nullptr or removed.
+    // The removed nodes met on the way are unlinked, so the last node returned was not removed when it was read
+    NodePtr lastNode(NodePtr prevNode) {
+        if (prevNode != nullptr && prevNode->isDeleted())
+            prevNode = nullptr;
+        while (true) {
+            NodePtr node = prevNode == nullptr ? Head() : nextOf(prevNode);
+            if (node == nullptr) {
+                if (prevNode == nullptr || !prevNode->isDeleted())
+                    return prevNode;
+                prevNode = nullptr;
+            } else if (node->isDeleted()) {
+                helpUnlink(prevNode, node);
+            } else {
+                prevNode = node;
+            }
         }
-        return nodeInChain && checkNode == endNode;
     }
 
-    void fixInsert(shared_ptr<NODE> node, shared_ptr<NODE> prevNode, shared_ptr<NODE> nextNode) {
-        shared_ptr<NODE> actualNextNode = nextNode;
-        if (nextNode->isDeleted()) {
-            actualNextNode = getValidNext(nextNode);
+    // Claims node for removal with the i-th unlink note of the thread, which keeps nextNode, its successor
+    bool claim(const NodePtr& node, size_t i, NodePtr& nextNode) {
+        nextNode = nextOf(node);
+        typename Notes::Note& note = Notes::Local(i);
+        note.claims.store(note.claims.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        note.next.Store(nextNode);
+        return node->CompareAndSetNext(nextNode, note.marker);
+    }
+
+    // Swings the link into node, the next_ of prevNode or head_ for nullptr, over to nextNode
+    bool unlinkAt(const NodePtr& prevNode, const NodePtr& node, const NodePtr& nextNode) {
+        if (prevNode == nullptr ? this->head_.CompareAndSet(node, nextNode)
+                                : prevNode->CompareAndSetNext(node, nextNode))
+            return true;
+        stats_.Count(prevNode == nullptr ? ListEvent::kHeadCasFailure : ListEvent::kNextCasFailure);
+        return false;
+    }
+
+    /**
+     * Unlinks node, removed by another thread and linked right after prevNode, the head for nullptr, instead of
+     * waiting for its remover: the unlink note linked as next_ of node keeps its successor. A note reused for a later
+     * removal fails the CAS, as the link into node is gone by then, a late store to helped names an older claim.
+     */
+    void helpUnlink(const NodePtr& prevNode, const NodePtr& node) {
+        typename Notes::Note* note = Notes::Of(node.get());
+        if (note == nullptr)
+            return;
+        uint64_t claim = note->claims.load();
+        if (unlinkAt(prevNode, node, note->next.Load())) {
+            note->helped.store(claim);
+            stats_.Count(ListEvent::kHelpUnlink);
         }
-        shared_ptr<NODE> actualPrevNode = prevNode;
-        if (actualPrevNode == nullptr)
-            updateHead(node);
-        else if (prevNode->isDeleted()) {
-            actualPrevNode = getValidPrev(actualNextNode);
-            if (actualPrevNode == nullptr || actualPrevNode == node)
-                updateHead(node);
+    }
+
+    /**
+     * Unlinks the run of count nodes claimed from first on with the unlink notes 0..count-1 of the thread.
+     * While first is linked one CAS swings the link into it over to the node behind the run. Threads meeting the run
+     * unlink its nodes one by one meanwhile (helpUnlink), the rest of the run is then unlinked from the first node
+     * still linked. Nodes inserted before it take over the link, so it is searched again until the CAS succeeds or
+     * the last node is unlinked by another thread, the run is unreachable from then on and its nodes may be retired
+     * after the hints are settled.
+     */
+    void unlinkRun(NodePtr node, size_t count, NodePtr prevNode) {
+        BACKOFF backoff;
+        NodePtr nextNode = Notes::Local(count - 1).next.Load();
+        size_t i = 0;
+        while (true) {
+            typename Notes::Note& note = Notes::Local(i);
+            bool helped = note.helped.load() == note.claims.load(memory_order_relaxed);
+            if (!helped && findPrev(node, prevNode, prevNode)) {
+                if (unlinkAt(prevNode, node, nextNode))
+                    break;
+                stats_.Count(ListEvent::kFixDelete);
+                backoff.Wait();
+            } else if (++i == count) {
+                break;
+            } else {
+                node = note.next.Load();
+            }
+        }
+        // the successors kept in the notes must not keep shared_ptr nodes alive
+        for (i = 0; i < count; i++)
+            Notes::Local(i).next.Store(nullptr);
+
+        if (nextNode != nullptr)
+            settlePrev(nextNode, prevNode);
+        // only a tail_ on a removed node is left to this remover, it moves to the neighbours of the run first, which
+        // spares the search from the head in settleTail. A tail_ stored later is settled by its own writer
+        NodePtr tail = Tail();
+        if (tail != nullptr && tail->isDeleted()) {
+            tail_.CompareAndSet(tail, nextNode != nullptr ? nextNode : prevNode);
+            settleTail();
+        }
+    }
+
+    /**
+     * Points the prev_ of a bidirectional node at the node linked before it, prevNode is the expected one and the
+     * prev_ of a removed node is cleared. The stored prev_ is checked again, a concurrent insert or removal in
+     * between either settles it after this one or is seen here, so no prev_ keeps naming a removed node.
+     *
+     * @return True if neither prevNode nor the prev_ were right, which took a search from the head.
+     */
+    bool settlePrev(const NodePtr& node, NodePtr prevNode) {
+        if (!Self::hasPrev())
+            return false;
+        bool searched = false;
+        BACKOFF backoff;
+        NodePtr oldPrev = self().getPrev(node);
+        while (true) {
+            if (node->isDeleted()) {
+                prevNode = nullptr;
+            } else if (!isPrevOf(prevNode, node)) {
+                if (isPrevOf(oldPrev, node))
+                    return searched;
+                if (!searched)
+                    stats_.Count(ListEvent::kFixPrev);
+                searched = true;
+                if (!findPrev(node, nullptr, prevNode)) {
+                    if (!node->isDeleted())
+                        return searched; // not linked
+                    continue; // removed meanwhile, its prev_ is cleared
+                }
+            }
+            if (oldPrev == prevNode)
+                return searched;
+            if (self().compareAndSetPrev(node, oldPrev, prevNode)) {
+                oldPrev = prevNode;
+            } else {
+                oldPrev = self().getPrev(node);
+                backoff.Wait();
+            }
+        }
+    }
+
+    /**
+     * Moves tail_ forward to the last node, or from a removed node to the last node searched from the head.
+     * The stored tail_ is checked again until it names the last node, so no tail_ keeps naming a removed node.
+     */
+    void settleTail() {
+        BACKOFF backoff;
+        NodePtr tail = Tail();
+        while (true) {
+            NodePtr last = lastNode(tail);
+            if (last == tail)
+                return;
+            if (tail_.CompareAndSet(tail, last)) {
+                tail = last;
+            } else {
+                stats_.Count(ListEvent::kTailCasFailure);
+                tail = Tail();
+                backoff.Wait();
+            }
+        }
+    }
+
+    // Wires the prev_ of a private chain, a single node or a singly linked list has nothing to wire.
+    // The walk also stops at a null next, so no prev_ is stored through a null node if last is not in the chain.
+    void linkChainPrev(const NodePtr& first, const NodePtr& last) {
+        if (!Self::hasPrev())
+            return;
+        NodePtr node = first;
+        while (node != last) {
+            NodePtr nextNode = nextOf(node);
+            if (nextNode == nullptr)
+                break;
+            self().setPrev(nextNode, node);
+            node = nextNode;
         }
-        if ((actualNextNode == nullptr || actualPrevNode == actualNextNode) && node != Tail())
-            this->updateTail(node);
-        else if (actualPrevNode == node || actualPrevNode == nullptr)
-            actualPrevNode = Head();
-
-        // Fix forward chain
-        if (actualPrevNode != nullptr && !isNodeIn(node, actualPrevNode, actualNextNode, false)) {
-            actualNextNode = getValidNext(actualPrevNode);
-            if (actualNextNode != nextNode && (actualNextNode == nullptr || !actualNextNode->isDeleted()))
-                this->updateNext(node, actualNextNode, nextNode);
-            this->updateNext(actualPrevNode, node);
-        } else if (node->Next() == nextNode && nextNode != actualNextNode && (actualNextNode == nullptr || !actualNextNode->isDeleted()))
-            this->updateNext(node, actualNextNode, nextNode);
-
-        // Fix backward chain
-        if (hasPrev())
-            fixPrev(nextNode, actualPrevNode, actualNextNode);
     }
 };
 
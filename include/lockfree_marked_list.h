@@ -0,0 +1,644 @@
+#ifndef LOCKFREE_MARKED_LIST_H
+#define LOCKFREE_MARKED_LIST_H
+
+#include <memory>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "lockfree_reclaim.h"
+#include "lockfree_backoff.h"
+#include "lockfree_counter.h"
+#include "lockfree_iterator.h"
+#include "lockfree_layout.h"
+#include "lockfree_marked_node.h"
+#include "lockfree_read_guard.h"
+#include "lockfree_stats.h"
+
+/**
+ * Harris-Michael list on nodes with a marked next_ (see lockfree_marked_node.h).
+ * Remove first marks the node, the successor is kept in the marked link, then the node is unlinked with one CAS
+ * on its predecessor. If that CAS fails, or a traversal meets a marked node, the search unlinks it on the way,
+ * so no repair walk is needed. The forward chain is the only authority, tail_ and the prev_ of bidirectional
+ * nodes are hints validated against it.
+ * A sentinel node stands before the first node, so the head is just the next_ of the sentinel.
+ * LAYOUT places the sentinel, tail_ and size_, see lockfree_layout.h. BACKOFF paces the retries, see lockfree_backoff.h.
+ * STATS counts the failed CAS, retries and searches, see lockfree_stats.h.
+ * DERIVED is the bidirectional list deriving from it, its prev_ hooks are called on it directly, void otherwise.
+ */
+template<typename NODE, typename RECLAIM = SharedPtrReclaim, typename COUNTER = ExactCounter,
+         typename LAYOUT = CompactLayout, typename BACKOFF = NoBackoff, typename STATS = NoStats,
+         typename DERIVED = void>
+class LockFreeMarkedList {
+public:
+    using NodeType = NODE;
+    using Self = typename conditional<is_void<DERIVED>::value, LockFreeMarkedList, DERIVED>::type;
+    using NodePtr = typename RECLAIM::template Ptr<NODE>;
+    using Guard = typename RECLAIM::Guard;
+    using iterator = LockFreeListIterator<LockFreeMarkedList>;
+    using ReadGuard = LockFreeReadGuard<LockFreeMarkedList, RECLAIM>;
+
+    LockFreeMarkedList() {
+        sentinel_ = RECLAIM::template Unmanaged<NODE>(&sentinelNode_);
+        tail_.Store(sentinel_);
+    }
+
+    // Unlinks the chain node by node, releasing the first node would release the whole shared_ptr chain recursively
+    virtual ~LockFreeMarkedList() {
+        NodePtr node = nextOf(sentinel_);
+        sentinel_->SetNext(nullptr);
+        while (node != nullptr) {
+            NodePtr nextNode = nextOf(node);
+            node->SetNext(nullptr);
+            clearPrev(node, integral_constant<bool, Self::hasPrev()>());
+            node = nextNode;
+        }
+    }
+
+    /**
+     * Inserts a new node at the head of the list.
+     *
+     * @param node The new node to be inserted.
+     * @param forceSuccess Retry until the insertion succeeds.
+     * @return True if the insertion is successful, false otherwise.
+     */
+    bool InsertHead(const NodePtr& node, bool forceSuccess=true) {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr first = nextOf(sentinel_);
+            node->SetNext(first);
+            self().setPrev(node, sentinel_);
+            if (sentinel_->CompareAndSetNext(first, node)) {
+                this->size_.Add(1);
+                if (first != nullptr)
+                    self().setPrev(first, node);
+                return true;
+            }
+            stats_.Count(ListEvent::kHeadCasFailure);
+            if (!forceSuccess)
+                return false;
+            stats_.Count(ListEvent::kInsertRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Appends a new node at the tail of the list, the search starts from the tail_ hint.
+     *
+     * @param node The new node to be appended.
+     * @param forceSuccess Retry until the insertion succeeds.
+     * @return True if the insertion is successful, false otherwise.
+     */
+    bool Append(const NodePtr& node, bool forceSuccess=true) {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr hint = tail_.Load();
+            NodePtr last = lastNode(hint);
+            node->SetNext(nullptr);
+            self().setPrev(node, last);
+            if (last->CompareAndSetNext(nullptr, node)) {
+                this->size_.Add(1);
+                if (!tail_.CompareAndSet(hint, node))
+                    stats_.Count(ListEvent::kTailCasFailure);
+                return true;
+            }
+            stats_.Count(ListEvent::kNextCasFailure);
+            if (!forceSuccess)
+                return false;
+            stats_.Count(ListEvent::kAppendRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Inserts a privately built chain of nodes at the head of the list with one CAS on the sentinel.
+     * The chain is linked from first to last with SetNext by the caller, the list wires the prev_ of
+     * bidirectional nodes before the chain is published and adds count to the size once.
+     *
+     * @param first The first node of the chain.
+     * @param last The last node of the chain, first for a single node.
+     * @param count The number of nodes from first to last.
+     * @param forceSuccess Retry until the insertion succeeds.
+     * @return True if the insertion is successful, false otherwise.
+     */
+    bool InsertHeadChain(const NodePtr& first, const NodePtr& last, int64_t count, bool forceSuccess=true) {
+        Guard guard;
+        linkChainPrev(first, last);
+        BACKOFF backoff;
+        while (true) {
+            NodePtr head = nextOf(sentinel_);
+            last->SetNext(head);
+            self().setPrev(first, sentinel_);
+            if (sentinel_->CompareAndSetNext(head, first)) {
+                this->size_.Add(count);
+                if (head != nullptr)
+                    self().setPrev(head, last);
+                return true;
+            }
+            stats_.Count(ListEvent::kHeadCasFailure);
+            if (!forceSuccess)
+                return false;
+            stats_.Count(ListEvent::kInsertRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Appends a privately built chain of nodes with one link CAS and one tail_ update, see InsertHeadChain.
+     *
+     * @param first The first node of the chain.
+     * @param last The last node of the chain, first for a single node.
+     * @param count The number of nodes from first to last.
+     * @param forceSuccess Retry until the insertion succeeds.
+     * @return True if the insertion is successful, false otherwise.
+     */
+    bool AppendChain(const NodePtr& first, const NodePtr& last, int64_t count, bool forceSuccess=true) {
+        Guard guard;
+        linkChainPrev(first, last);
+        BACKOFF backoff;
+        while (true) {
+            NodePtr hint = tail_.Load();
+            NodePtr lastLinked = lastNode(hint);
+            last->SetNext(nullptr);
+            self().setPrev(first, lastLinked);
+            if (lastLinked->CompareAndSetNext(nullptr, first)) {
+                this->size_.Add(count);
+                if (!tail_.CompareAndSet(hint, last))
+                    stats_.Count(ListEvent::kTailCasFailure);
+                return true;
+            }
+            stats_.Count(ListEvent::kNextCasFailure);
+            if (!forceSuccess)
+                return false;
+            stats_.Count(ListEvent::kAppendRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Inserts a new node before a target node, a deleted target is replaced by its next valid node.
+     *
+     * @param node The new node to be inserted.
+     * @param targetNode The node before which the new node is inserted, nullptr appends.
+     * @param forceSuccess Retry until the insertion succeeds.
+     * @return True if the insertion is successful, false otherwise or if targetNode is not in the list.
+     */
+    bool Insert(const NodePtr& node, const NodePtr& targetNode, bool forceSuccess=true) {
+        return Insert(node, targetNode, nullptr, forceSuccess);
+    }
+
+    /**
+     * Inserts a new node before a target node with the caller's guess of the target's predecessor,
+     * a valid hint saves the search of the predecessor, a stale one falls back to the search.
+     *
+     * @param node The new node to be inserted.
+     * @param targetNode The node before which the new node is inserted, nullptr appends.
+     * @param prevHint The node expected right before targetNode, nullptr if unknown.
+     * @param forceSuccess Retry until the insertion succeeds.
+     * @return True if the insertion is successful, false otherwise or if targetNode is not in the list.
+     */
+    bool Insert(const NodePtr& node, const NodePtr& targetNode, const NodePtr& prevHint, bool forceSuccess=true) {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr nextNode = targetNode;
+            if (nextNode != nullptr && nextNode->isDeleted())
+                nextNode = getValidNext(nextNode);
+            if (nextNode == nullptr)
+                return Append(node, forceSuccess);
+
+            NodePtr prevNode = findPrev(nextNode, nextNode == targetNode ? prevHint : nullptr);
+            if (prevNode != nullptr) {
+                node->SetNext(nextNode);
+                self().setPrev(node, prevNode);
+                if (prevNode->CompareAndSetNext(nextNode, node)) {
+                    this->size_.Add(1);
+                    self().setPrev(nextNode, node);
+                    return true;
+                }
+                stats_.Count(ListEvent::kNextCasFailure);
+            } else if (!nextNode->isDeleted()) {
+                return false;
+            }
+            if (!forceSuccess)
+                return false;
+            stats_.Count(ListEvent::kInsertRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Creates a node with RECLAIM::Make, its data_ constructed in place from args, and appends it.
+     * With SharedPtrReclaim the node and its control block are one allocation.
+     *
+     * @param args The arguments of a constructor of the data.
+     * @return The new node, callers of EpochReclaim lists hold a Guard as long as they use it.
+     */
+    template<typename... ARGS>
+    NodePtr Emplace(ARGS&&... args) {
+        NodePtr node = RECLAIM::template Make<NODE>(std::forward<ARGS>(args)...);
+        Append(node);
+        return node;
+    }
+
+    /**
+     * Creates a node as Emplace does and inserts it at the head of the list.
+     */
+    template<typename... ARGS>
+    NodePtr EmplaceHead(ARGS&&... args) {
+        NodePtr node = RECLAIM::template Make<NODE>(std::forward<ARGS>(args)...);
+        InsertHead(node);
+        return node;
+    }
+
+    /**
+     * Creates a node as Emplace does and inserts it before targetNode, see Insert.
+     *
+     * @return The new node, nullptr if targetNode is not in the list.
+     */
+    template<typename... ARGS>
+    NodePtr EmplaceBefore(const NodePtr& targetNode, ARGS&&... args) {
+        NodePtr node = RECLAIM::template Make<NODE>(std::forward<ARGS>(args)...);
+        return Insert(node, targetNode) ? node : nullptr;
+    }
+
+    NodePtr Head() const {
+        Guard guard;
+        while (true) {
+            NodePtr first = nextOf(sentinel_);
+            if (first == nullptr || !first->isDeleted())
+                return first;
+            sentinel_->CompareAndSetNext(first, nextOf(first));
+        }
+    }
+
+    NodePtr Tail() const {
+        Guard guard;
+        NodePtr last = lastNode(tail_.Load());
+        return last == sentinel_ ? nullptr : last;
+    }
+
+    /**
+     * @return The number of nodes, -1 if COUNTER does not track the size.
+     */
+    int64_t Size() const {
+        return size_.Get();
+    }
+
+    /**
+     * @return The contention counts so far, all zeros if STATS does not count, see lockfree_stats.h.
+     */
+    ListStats Stats() const {
+        return stats_.Snapshot();
+    }
+
+    /**
+     * Weakly consistent iteration from the head, see lockfree_iterator.h.
+     */
+    iterator begin() {
+        return iterator(this, Head());
+    }
+
+    iterator end() {
+        return iterator(this, nullptr);
+    }
+
+    NodePtr GetNext(const NodePtr& node) {
+        if (nullptr == node)
+            return nullptr;
+        Guard guard;
+        return getValidNext(node);
+    }
+
+    NodePtr GetPrev(const NodePtr& node) {
+        if (nullptr == node)
+            return nullptr;
+        Guard guard;
+        NodePtr prevNode = findPrev(node);
+        return prevNode == sentinel_ ? nullptr : prevNode;
+    }
+
+    NodePtr PopHead(void) {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr head = Head();
+            if (nullptr == head || Remove(head, false))
+                return head;
+            stats_.Count(ListEvent::kRemoveRetry);
+            backoff.Wait();
+        }
+    }
+
+    NodePtr PopTail(void) {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr tail = Tail();
+            if (nullptr == tail || Remove(tail, false))
+                return tail;
+            stats_.Count(ListEvent::kRemoveRetry);
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Removes the head as PopHead() does and moves its data_ out, e.g. for move-only data.
+     * The removed node keeps a moved-from data_, which another thread still holding the node (an iterator,
+     * a ReadGuard, ...) must not read.
+     *
+     * @param value Receives the data of the removed node.
+     * @return True if a node was removed, false if the list is empty.
+     */
+    template<typename VALUE>
+    bool PopHead(VALUE& value) {
+        Guard guard;
+        NodePtr head = PopHead();
+        if (nullptr == head)
+            return false;
+        value = std::move(head->data_);
+        return true;
+    }
+
+    /**
+     * Removes the tail as PopTail() does and moves its data_ out, see PopHead(value).
+     */
+    template<typename VALUE>
+    bool PopTail(VALUE& value) {
+        Guard guard;
+        NodePtr tail = PopTail();
+        if (nullptr == tail)
+            return false;
+        value = std::move(tail->data_);
+        return true;
+    }
+
+    /**
+     * Removes up to n nodes from the head in one pass: every node is marked by its own CAS, as PopHead does,
+     * then the marked run is unlinked from the sentinel with one CAS and the size is updated once.
+     * If the CAS fails the search unlinks what is left of the run.
+     *
+     * @param n The maximum number of nodes to remove.
+     * @param out A vector or deque, receives the removed nodes in list order.
+     * @return The number of nodes removed, 0 if the list is empty.
+     */
+    template<typename OUT>
+    size_t PopHeadN(size_t n, OUT& out) {
+        Guard guard;
+        NodePtr first = Head();
+        NodePtr node = first;
+        size_t count = 0;
+        while (node != nullptr && count < n) {
+            auto next = node->next_.get();
+            NodePtr nextNode = RECLAIM::template Cast<NODE>(next.first);
+            if (next.second) {
+                node = nextNode; // marked by another remover, its successor is kept
+                continue;
+            }
+            if (node->Delete(nextNode)) {
+                out.push_back(node);
+                count++;
+                node = nextNode;
+            }
+        }
+        if (count == 0)
+            return 0;
+        this->size_.Add(-int64_t(count));
+
+        NodePtr prevNode = sentinel_;
+        if (!sentinel_->CompareAndSetNext(first, node))
+            locate(node, prevNode, sentinel_);
+        if (node == nullptr)
+            tail_.CompareAndSet(out.back(), prevNode);
+        else if (nextOf(prevNode) == node)
+            self().setPrev(node, prevNode);
+        return count;
+    }
+
+    /**
+     * Drains the list with PopHeadN batches until Head() finds it empty, an empty batch while a removal by another
+     * thread is still being unlinked does not end it. It is a batched drain, not an O(1) detach: every node is still
+     * claimed by a CAS of its own, so the cost is O(n), and nodes appended meanwhile are drained too.
+     *
+     * @return The removed nodes, in the order they were removed.
+     */
+    vector<NodePtr> DrainAll() {
+        vector<NodePtr> nodes;
+        while (Head() != nullptr)
+            PopHeadN(numeric_limits<size_t>::max(), nodes);
+        return nodes;
+    }
+
+    /**
+     * Removes a node from the list.
+     * The node is deleted once its next_ is marked, the unlink that follows never fails:
+     * whoever finds the marked node first unlinks it.
+     *
+     * @param node The node to be removed.
+     * @param forceSuccess Retry the mark if a node is inserted right after the node concurrently.
+     * @return True if this call deleted the node, false if it is already deleted.
+     */
+    bool Remove(const NodePtr& node, bool forceSuccess=true) {
+        return Remove(node, nullptr, forceSuccess);
+    }
+
+    /**
+     * Removes a node with the caller's guess of its predecessor, e.g. the node visited right before it.
+     * A valid hint unlinks the node without searching its predecessor, a stale one falls back to the search.
+     *
+     * @param node The node to be removed.
+     * @param prevHint The node expected right before node, nullptr if unknown.
+     * @param forceSuccess Retry the mark if a node is inserted right after the node concurrently.
+     * @return True if this call deleted the node, false if it is already deleted.
+     */
+    bool Remove(const NodePtr& node, const NodePtr& prevHint, bool forceSuccess=true) {
+        if (node == nullptr)
+            return false;
+        Guard guard;
+        BACKOFF backoff;
+        NodePtr nextNode;
+        while (true) {
+            auto next = node->next_.get();
+            if (next.second)
+                return false;
+            nextNode = RECLAIM::template Cast<NODE>(next.first);
+            if (node->Delete(nextNode))
+                break;
+            if (!forceSuccess)
+                return false;
+            stats_.Count(ListEvent::kRemoveRetry);
+            backoff.Wait();
+        }
+        this->size_.Add(-1);
+
+        NodePtr prevNode = prevHint != nullptr ? prevHint : self().getPrev(node);
+        if (prevNode == nullptr || prevNode->isDeleted() || !prevNode->CompareAndSetNext(node, nextNode)) {
+            // the predecessor changed, the search unlinks the node or finds it unlinked already
+            locate(node, prevNode, sentinel_);
+        }
+        if (nextNode == nullptr)
+            tail_.CompareAndSet(node, prevNode);
+        else if (nextOf(prevNode) == nextNode)
+            self().setPrev(nextNode, prevNode);
+        return true;
+    }
+
+    /**
+     * This function is used for testing only, it only works in thread-safe mode.
+     * It checks that no reachable node is marked, the prev of every node of a bidirectional list matches
+     * the forward chain and the size of the list is correct.
+     * @param count The expected size of the list, if not provided, it is ignored.
+     * @return True if the list is consistent, false otherwise.
+     */
+    bool CheckConsistence(int64_t count = -1) {
+        Guard guard;
+        NodePtr prevNode = sentinel_;
+        NodePtr node = nextOf(sentinel_);
+        int i = 0;
+        while (node != nullptr) {
+            if (node->isDeleted()) {
+                std::cout << "fatal: " << node.get() << " is deleted" << endl;
+                return false;
+            }
+            if (self().getPrev(node) != nullptr && findPrev(node) != prevNode) {
+                std::cout << "fatal: wrong prev of " << node.get() << endl;
+                return false;
+            }
+            prevNode = node;
+            node = nextOf(node);
+            i++;
+        }
+
+        if (count != -1 && ((COUNTER::kEnabled && this->size_.Get() != count) || i != count)) {
+            cout << "count:" << count << "actualCount: " << this->size_.Get() << " linked: " << i << endl;
+            return false;
+        }
+        return true;
+    }
+
+protected:
+    typename LAYOUT::template Slot<NODE> sentinelNode_;
+    NodePtr sentinel_;
+    typename LAYOUT::template Slot<typename RECLAIM::template Link<NODE>> tail_;
+    typename LAYOUT::template Slot<COUNTER> size_;
+    mutable STATS stats_;
+
+    // The prev_ hooks of a singly linked list, a bidirectional DERIVED hides them with its own
+    static constexpr bool hasPrev() {return false;}
+    void setPrev(const NodePtr&, const NodePtr&) {}
+    NodePtr getPrev(const NodePtr&) const {return nullptr;}
+
+    // The destructor clears prev_ on the node itself, DERIVED is already destroyed by then
+    static void clearPrev(const NodePtr& node, true_type) {node->SetPrev(nullptr);}
+    static void clearPrev(const NodePtr&, false_type) {}
+
+    Self& self() {
+        return static_cast<Self&>(*this);
+    }
+
+    const Self& self() const {
+        return static_cast<const Self&>(*this);
+    }
+
+    NodePtr nextOf(const NodePtr& node) const {
+        return RECLAIM::template Cast<NODE>(node->Next());
+    }
+
+    NodePtr getValidNext(const NodePtr& node) const {
+        NodePtr nextNode = nextOf(node);
+        uint64_t steps = 0;
+        while (nextNode != nullptr && nextNode->isDeleted()) {
+            nextNode = nextOf(nextNode);
+            steps++;
+        }
+        stats_.Walk(ListWalk::kValidNext, steps);
+        return nextNode;
+    }
+
+    // Wires the prev_ of a private chain, a single node or a singly linked list has nothing to wire
+    void linkChainPrev(const NodePtr& first, const NodePtr& last) {
+        if (!Self::hasPrev())
+            return;
+        for (NodePtr node = first; node != last; ) {
+            NodePtr nextNode = nextOf(node);
+            self().setPrev(nextNode, node);
+            node = nextNode;
+        }
+    }
+
+    /**
+     * Returns the unmarked node linked right before node, the sentinel for the first node,
+     * nullptr if node is not linked. The caller's hint or the prev hint of the node is tried first,
+     * the search from the sentinel is the slow path.
+     */
+    NodePtr findPrev(const NodePtr& node, const NodePtr& prevHint = nullptr) const {
+        NodePtr prevNode = prevHint != nullptr ? prevHint : self().getPrev(node);
+        if (prevNode != nullptr && !prevNode->isDeleted() && prevNode->Next() == node)
+            return prevNode;
+        if (locate(node, prevNode, sentinel_))
+            return prevNode;
+        return nullptr;
+    }
+
+    /**
+     * Returns the last linked node, the sentinel if the list is empty.
+     * @param hint The tail_ hint to start from, ignored if deleted.
+     */
+    NodePtr lastNode(const NodePtr& hint) const {
+        NodePtr lastNode;
+        locate(nullptr, lastNode, hint == nullptr || hint->isDeleted() ? sentinel_ : hint);
+        return lastNode;
+    }
+
+    /**
+     * Walks from startNode to targetNode, nullptr for the end of the list, and unlinks every marked node on the way
+     * with one CAS on its predecessor. Restarts from the sentinel if the predecessor is marked meanwhile.
+     *
+     * @param targetNode The node to look for.
+     * @param prevNode Set to the last unmarked node before targetNode or before the end.
+     * @param startNode An unmarked node to start from.
+     * @return True if targetNode is linked and not marked, false if it is not linked any more.
+     */
+    bool locate(const NodePtr& targetNode, NodePtr& prevNode, const NodePtr& startNode) const {
+        prevNode = startNode;
+        NodePtr node = nextOf(prevNode);
+        uint64_t steps = 0;
+        while (node != nullptr) {
+            auto next = node->next_.get();
+            NodePtr nextNode = RECLAIM::template Cast<NODE>(next.first);
+            steps++;
+            if (!next.second) {
+                if (node == targetNode) {
+                    stats_.Walk(ListWalk::kLocate, steps);
+                    return true;
+                }
+                prevNode = node;
+                node = nextNode;
+                continue;
+            }
+            if (prevNode->CompareAndSetNext(node, nextNode)) {
+                if (node == targetNode) {
+                    stats_.Walk(ListWalk::kLocate, steps);
+                    return false;
+                }
+                node = nextNode;
+                continue;
+            }
+            stats_.Count(ListEvent::kNextCasFailure);
+            if (prevNode->isDeleted()) {
+                prevNode = sentinel_;
+                node = nextOf(prevNode);
+            } else {
+                node = nextOf(prevNode);
+            }
+        }
+        stats_.Walk(ListWalk::kLocate, steps);
+        return targetNode == nullptr;
+    }
+};
+
+#endif //LOCKFREE_MARKED_LIST_H
@@ -0,0 +1,102 @@
+#ifndef LOCKFREE_MARKED_NODE_H
+#define LOCKFREE_MARKED_NODE_H
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "lockfree_reclaim.h"
+#include "marked_atomic.h"
+
+using namespace std;
+
+/**
+ * Harris style node: deletion sets the mark bit of next_ and keeps the successor,
+ * so any thread can unlink a deleted node with one CAS on its predecessor.
+ * Use it through the node switch of the lists, e.g. LockFreeSiList<T, SharedPtrReclaim, LockFreeMarkedNode>.
+ */
+template<typename T, typename RECLAIM = SharedPtrReclaim>
+struct LockFreeMarkedNode {
+    static_assert(!RECLAIM::kOwnsNodes, "marked nodes keep removed nodes reachable through hints, use SharedPtrReclaim");
+
+    using NodePtr = typename RECLAIM::template Ptr<LockFreeMarkedNode<T, RECLAIM>>;
+
+    MarkedAtomic<LockFreeMarkedNode<T, RECLAIM>> next_;
+    T data_;
+
+    LockFreeMarkedNode() {}
+
+    LockFreeMarkedNode(T data) : data_(std::move(data)) {}
+
+    // Constructs data_ in place from the arguments of a constructor of T, see Emplace of the lists
+    template<typename... ARGS, typename = typename enable_if<is_constructible<T, ARGS&&...>::value>::type>
+    explicit LockFreeMarkedNode(ARGS&&... args) : data_(std::forward<ARGS>(args)...) {}
+
+    // The memory of the node comes from RECLAIM, see PooledReclaim in lockfree_pool.h
+    static void* operator new(size_t size) {
+        return RECLAIM::Allocate(size);
+    }
+
+    static void operator delete(void* address, size_t size) {
+        RECLAIM::Deallocate(address, size);
+    }
+
+    // The successor, a deleted node still returns the successor it had when it was deleted
+    NodePtr Next() {
+        return next_.getPtr();
+    }
+
+    // A marked link is a shared_ptr, it can not be read cheaply for prefetching
+    const void* NextHint() const {
+        return nullptr;
+    }
+
+    void SetNext(const NodePtr& node) {
+        next_.set(node, false);
+    }
+
+    bool isDeleted() {
+        return next_.isMarked();
+    }
+
+    bool Delete(const NodePtr& oldNext) {
+        return next_.compareAndSet(oldNext, oldNext, false, true);
+    }
+
+    bool CompareAndSetNext(const NodePtr& oldNext, const NodePtr& newNext) {
+        return next_.compareAndSet(oldNext, newNext, false, false);
+    }
+};
+
+/**
+ * Bidirectional Harris style node, prev_ is only a hint which the list validates against the forward chain.
+ */
+template <typename T, typename RECLAIM = SharedPtrReclaim>
+struct LockFreeMarkedBiNode : LockFreeMarkedNode<T, RECLAIM>
+{
+    using BiNodePtr = typename RECLAIM::template Ptr<LockFreeMarkedBiNode<T, RECLAIM>>;
+
+    typename RECLAIM::template Link<LockFreeMarkedBiNode<T, RECLAIM>> prev_;
+
+    LockFreeMarkedBiNode() {}
+
+    LockFreeMarkedBiNode(T data) : LockFreeMarkedNode<T, RECLAIM>(std::move(data)) {}
+
+    template<typename... ARGS, typename = typename enable_if<is_constructible<T, ARGS&&...>::value>::type>
+    explicit LockFreeMarkedBiNode(ARGS&&... args) : LockFreeMarkedNode<T, RECLAIM>(std::forward<ARGS>(args)...) {}
+
+    BiNodePtr Prev() {
+        return prev_.Load();
+    }
+
+    // The previous node for prefetching only, it may be stale or nullptr
+    const void* PrevHint() const {
+        return prev_.Hint();
+    }
+
+    void SetPrev(const BiNodePtr& node) {
+        prev_.Store(node);
+    }
+};
+#endif //LOCKFREE_MARKED_NODE_H
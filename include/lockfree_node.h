@@ -7,49 +7,89 @@
 
 #include <atomic>
 #include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "lockfree_reclaim.h"
+#include "lockfree_unlink.h"
 
 using namespace std;
 
-template<typename T>
+/**
+ * Node of the default deletion scheme, Delete links the dummyNode sentinel instead of the successor, the lists link
+ * a Marker, which keeps the successor in an unlink note (see lockfree_unlink.h).
+ * No member is virtual: the lists resolve single or bidirectional linking at compile time, so a node holds
+ * its links and data only, and is always destroyed as the node type of its list.
+ */
+template<typename T, typename RECLAIM = SharedPtrReclaim>
 struct LockFreeNode {
-    shared_ptr<LockFreeNode<T>> next_;
+    using NodePtr = typename RECLAIM::template Ptr<LockFreeNode<T, RECLAIM>>;
+
+    typename RECLAIM::template Link<LockFreeNode<T, RECLAIM>> next_;
     T data_;
 
     LockFreeNode() {}
 
-    LockFreeNode(T data) : data_(data) {}
+    LockFreeNode(T data) : data_(std::move(data)) {}
+
+    // Constructs data_ in place from the arguments of a constructor of T, see Emplace of the lists
+    template<typename... ARGS, typename = typename enable_if<is_constructible<T, ARGS&&...>::value>::type>
+    explicit LockFreeNode(ARGS&&... args) : data_(std::forward<ARGS>(args)...) {}
 
-    virtual ~LockFreeNode() {}
+    // The memory of the node comes from RECLAIM, see PooledReclaim in lockfree_pool.h
+    static void* operator new(size_t size) {
+        return RECLAIM::Allocate(size);
+    }
+
+    static void operator delete(void* address, size_t size) {
+        RECLAIM::Deallocate(address, size);
+    }
 
-    virtual shared_ptr<LockFreeNode<T>> Next() {
-        shared_ptr<LockFreeNode<T>> nextNode = atomic_load(&next_);
-        if (nextNode == dummyNode)
+    NodePtr Next() {
+        NodePtr nextNode = next_.Load();
+        if (nextNode == dummyNode || isUnlinkNote(nextNode.get()))
             return nullptr;
         return nextNode;
     }
 
-    virtual void SetNext(shared_ptr<LockFreeNode<T>> node) {
-        atomic_store(&next_, node);
+    // The next node for prefetching only, it may be stale, the sentinel, an unlink note or nullptr
+    const void* NextHint() const {
+        return next_.Hint();
     }
 
-    virtual bool isDeleted() {
-        return atomic_load(&next_) == dummyNode;
+    void SetNext(const NodePtr& node) {
+        next_.Store(node);
     }
 
-    virtual bool Delete(shared_ptr<LockFreeNode<T>> oldNext) {
-        return atomic_compare_exchange_strong(&next_, &oldNext, dummyNode);
+    bool isDeleted() {
+        const void* nextNode = next_.Peek();
+        return nextNode == dummyNode.get() || isUnlinkNote(nextNode);
     }
 
-    virtual bool CompareAndSetNext(shared_ptr<LockFreeNode<T>> oldNext, shared_ptr<LockFreeNode<T>> newNext) {
-        return atomic_compare_exchange_strong(&next_, &oldNext, newNext);
+    bool Delete(const NodePtr& oldNext) {
+        return next_.CompareAndSet(oldNext, dummyNode);
+    }
+
+    bool CompareAndSetNext(const NodePtr& oldNext, const NodePtr& newNext) {
+        return next_.CompareAndSet(oldNext, newNext);
+    }
+
+    // The next_ a list links to remove the node, the tagged address of a note keeping its successor (lockfree_unlink.h)
+    static NodePtr Marker(const void* note) {
+        return RECLAIM::template Unmanaged<LockFreeNode>(TagUnlinkNote<LockFreeNode>(note));
     }
 
 protected:
-    static const shared_ptr<LockFreeNode<T>> dummyNode;
+    static const NodePtr dummyNode;
+
+    // the deletion sentinel is only compared by address, raw storage so that T needs no default constructor
+    static LockFreeNode* sentinel() {
+        static typename aligned_storage<sizeof(LockFreeNode), alignof(LockFreeNode)>::type storage;
+        return reinterpret_cast<LockFreeNode*>(&storage);
+    }
 };
 
-template <typename T>
-const shared_ptr<LockFreeNode<T>> LockFreeNode<T>::dummyNode = shared_ptr<LockFreeNode<T>>(
-    new LockFreeNode<T>, [](LockFreeNode<T> *) {} // Custom deleter (no-op)
-);
+template <typename T, typename RECLAIM>
+const typename LockFreeNode<T, RECLAIM>::NodePtr LockFreeNode<T, RECLAIM>::dummyNode =
+    RECLAIM::template Unmanaged<LockFreeNode<T, RECLAIM>>(LockFreeNode<T, RECLAIM>::sentinel());
 #endif //LOCKFREE_NODE_H
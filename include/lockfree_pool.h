@@ -0,0 +1,300 @@
+#ifndef LOCKFREE_POOL_H
+#define LOCKFREE_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "lockfree_reclaim.h"
+#include "lockfree_util.h"
+
+using namespace std;
+
+/**
+ * Pool of cache-line-aligned blocks of one size class.
+ * Every thread keeps up to kMaxCached free blocks, an empty cache takes a batch of kBatch blocks from the depot,
+ * a full one gives a batch back, so the shared state is touched once per kBatch allocations.
+ * The depot is a Treiber stack of batches with a version tag in the top 16 bits of the pointer word
+ * against ABA, blocks are carved from slabs which are never returned, so a stale block is always readable.
+ * Slabs are 2MB huge pages, aligned to 2MB, if hugePages is set and the OS supports it.
+ */
+class NodePool {
+public:
+    static const size_t kBatch = 64;
+    static const size_t kMaxCached = 2 * kBatch;
+    static const size_t kSizeClasses = 16;  // blocks of 1..16 cache lines, larger sizes go to the heap
+    static const size_t kSlabBytes = 256 * 1024;
+    static const size_t kHugeSlabBytes = 2 * 1024 * 1024;
+
+    /**
+     * @return The pool of the size class of size, nullptr if size is larger than the largest class.
+     */
+    static NodePool* ForSize(size_t size, bool hugePages) {
+        size_t sizeClass = (size + kCacheLineSize - 1) / kCacheLineSize;
+        if (sizeClass == 0 || sizeClass > kSizeClasses)
+            return nullptr;
+        return pools(hugePages)[sizeClass - 1];
+    }
+
+    void* Allocate() {
+        ThreadCache& cache = threadCache();
+        if (cache.head == nullptr)
+            refill(cache);
+        Block* block = cache.head;
+        cache.head = block->next;
+        cache.count--;
+        if (cache.flushed && cache.head != nullptr) {
+            // the thread is exiting, its cache is gone, the rest of the batch goes back at once
+            cache.head->count = cache.count;
+            pushBatch(cache.head);
+            cache.head = nullptr;
+            cache.count = 0;
+        }
+        return block;
+    }
+
+    void Free(void* address) {
+        Block* block = new(address) Block();
+        ThreadCache& cache = threadCache();
+        if (cache.flushed) {
+            // the thread is exiting, its cache is gone
+            block->count = 1;
+            pushBatch(block);
+            return;
+        }
+        block->next = cache.head;
+        cache.head = block;
+        if (++cache.count > kMaxCached)
+            cache.head = popBatch(cache.head, kBatch, cache.count);
+    }
+
+    size_t BlockSize() const {
+        return blockSize_;
+    }
+
+    // Number of slabs taken from the OS, for statistics
+    size_t SlabCount() const {
+        return slabCount_.load(memory_order_relaxed);
+    }
+
+private:
+    struct Block {
+        Block* next;                // next free block of the batch or of a thread cache
+        atomic<Block*> nextBatch;   // next batch in the depot, only valid on the first block of a batch
+        size_t count;               // blocks in the batch, only valid on the first block of a batch
+
+        Block() : next(nullptr), nextBatch(nullptr), count(0) {}
+    };
+
+    // Trivially destructible, so it stays usable while thread_local destructors run
+    struct ThreadCache {
+        Block* head;
+        size_t count;
+        bool flushed;
+    };
+
+    struct CacheFlusher {
+        ~CacheFlusher();
+    };
+
+    static const uint64_t kPointerMask = (uint64_t(1) << 48) - 1;
+
+    const size_t blockSize_;
+    const size_t poolIndex_;
+    const bool hugePages_;
+    atomic<uint64_t> depot_;
+    atomic<void*> slabs_;  // every slab starts with the address of the previous one, keeps them reachable
+    atomic<size_t> slabCount_;
+
+    NodePool(size_t blockSize, size_t poolIndex, bool hugePages)
+        : blockSize_(blockSize), poolIndex_(poolIndex), hugePages_(hugePages), depot_(0), slabs_(nullptr), slabCount_(0) {
+        static_assert(sizeof(void*) == 8, "the depot tags the top 16 bits of 64-bit pointers");
+        static_assert(sizeof(Block) <= kCacheLineSize, "a free block must fit into the smallest block");
+    }
+
+    static NodePool** pools(bool hugePages) {
+        return allPools() + (hugePages ? kSizeClasses : 0);
+    }
+
+    // Never destroyed: nodes may be freed by static destructors, e.g. of the reclamation domains
+    static NodePool** allPools() {
+        static NodePool** all = createPools();
+        return all;
+    }
+
+    static NodePool** createPools() {
+        NodePool** all = new NodePool*[2 * kSizeClasses];
+        for (size_t i = 0; i < 2 * kSizeClasses; i++)
+            all[i] = new NodePool((i % kSizeClasses + 1) * kCacheLineSize, i, i >= kSizeClasses);
+        return all;
+    }
+
+    ThreadCache& threadCache() {
+        static thread_local CacheFlusher flusher;
+        (void)flusher;
+        return threadCaches()[poolIndex_];
+    }
+
+    static ThreadCache* threadCaches() {
+        static thread_local ThreadCache caches[2 * kSizeClasses];
+        return caches;
+    }
+
+    static Block* blockOf(uint64_t word) {
+        return reinterpret_cast<Block*>(word & kPointerMask);
+    }
+
+    static uint64_t wordOf(Block* block, uint64_t oldWord) {
+        return (((oldWord >> 48) + 1) << 48) | reinterpret_cast<uint64_t>(block);
+    }
+
+    void pushBatch(Block* batch) {
+        uint64_t top = depot_.load(memory_order_relaxed);
+        do {
+            batch->nextBatch.store(blockOf(top), memory_order_relaxed);
+        } while (!depot_.compare_exchange_weak(top, wordOf(batch, top), memory_order_release, memory_order_relaxed));
+    }
+
+    Block* tryPopBatch() {
+        uint64_t top = depot_.load(memory_order_acquire);
+        while (blockOf(top) != nullptr) {
+            Block* next = blockOf(top)->nextBatch.load(memory_order_relaxed);
+            if (depot_.compare_exchange_weak(top, wordOf(next, top), memory_order_acquire, memory_order_acquire))
+                return blockOf(top);
+        }
+        return nullptr;
+    }
+
+    /**
+     * Moves count blocks from the front of a cache list to the depot as one batch.
+     * @return The rest of the list.
+     */
+    Block* popBatch(Block* head, size_t count, size_t& cached) {
+        Block* last = head;
+        for (size_t i = 1; i < count; i++)
+            last = last->next;
+        Block* rest = last->next;
+        last->next = nullptr;
+        head->count = count;
+        pushBatch(head);
+        cached -= count;
+        return rest;
+    }
+
+    void refill(ThreadCache& cache) {
+        Block* batch = tryPopBatch();
+        if (batch != nullptr) {
+            cache.head = batch;
+            cache.count = batch->count;
+            return;
+        }
+        carveSlab(cache);
+    }
+
+    // Carves a new slab, the thread keeps one batch and gives the rest to the depot
+    void carveSlab(ThreadCache& cache) {
+        size_t slabBytes = hugePages_ ? kHugeSlabBytes : kSlabBytes;
+        char* slab = static_cast<char*>(allocateSlab(slabBytes));
+        void* lastSlab = slabs_.load(memory_order_relaxed);
+        do {
+            *reinterpret_cast<void**>(slab) = lastSlab;
+        } while (!slabs_.compare_exchange_weak(lastSlab, slab));
+        slabCount_.fetch_add(1, memory_order_relaxed);
+
+        // the first block holds the slab link
+        size_t blocks = slabBytes / blockSize_ - 1;
+        Block* head = nullptr;
+        for (size_t i = blocks; i > 0; i--) {
+            Block* block = new(slab + i * blockSize_) Block();
+            block->next = head;
+            head = block;
+        }
+        size_t count = blocks;
+        while (count > kBatch)
+            head = popBatch(head, kBatch, count);
+        cache.head = head;
+        cache.count = count;
+    }
+
+    void* allocateSlab(size_t bytes) {
+#ifdef __linux__
+        if (hugePages_) {
+            // a huge page backs the slab only if the slab starts on a huge page boundary: map one more huge page,
+            // then unmap the unaligned head and the tail
+            size_t mappedBytes = bytes + kHugeSlabBytes;
+            void* mapped = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped != MAP_FAILED) {
+                char* begin = static_cast<char*>(mapped);
+                char* slab = reinterpret_cast<char*>(
+                    (reinterpret_cast<uintptr_t>(begin) + kHugeSlabBytes - 1) & ~uintptr_t(kHugeSlabBytes - 1));
+                if (slab != begin)
+                    munmap(begin, slab - begin);
+                if (slab + bytes != begin + mappedBytes)
+                    munmap(slab + bytes, begin + mappedBytes - (slab + bytes));
+#ifdef MADV_HUGEPAGE
+                madvise(slab, bytes, MADV_HUGEPAGE);
+#endif
+                return slab;
+            }
+        }
+#endif
+        void* slab = nullptr;
+        if (posix_memalign(&slab, hugePages_ ? kHugeSlabBytes : kCacheLineSize, bytes) != 0)
+            throw bad_alloc();
+        return slab;
+    }
+};
+
+inline NodePool::CacheFlusher::~CacheFlusher() {
+    for (size_t i = 0; i < 2 * kSizeClasses; i++) {
+        NodePool* pool = allPools()[i];
+        ThreadCache& cache = threadCaches()[i];
+        if (cache.head != nullptr) {
+            cache.head->count = cache.count;
+            pool->pushBatch(cache.head);
+        }
+        cache.head = nullptr;
+        cache.count = 0;
+        cache.flushed = true;
+    }
+}
+
+/**
+ * Allocation policy wrapper of a reclamation policy: the nodes come from NodePool instead of the heap,
+ * and every node freed by RECLAIM (Retire, Destroy or the last shared_ptr) goes back to the pool.
+ * Nodes are created with PooledReclaim<RECLAIM>::Make<N>(args...), e.g.
+ *   LockFreeSiList<int, PooledReclaim<EpochReclaim>> list;
+ *   list.Append(PooledReclaim<EpochReclaim>::Make<LockFreeNode<int, PooledReclaim<EpochReclaim>>>(1));
+ * A SharedPtrReclaim node and its control block share one block.
+ */
+template<typename RECLAIM, bool HUGE_PAGES = false>
+struct PooledReclaim : RECLAIM {
+    static void* Allocate(size_t size) {
+        NodePool* pool = NodePool::ForSize(size, HUGE_PAGES);
+        return pool != nullptr ? pool->Allocate() : ::operator new(size);
+    }
+
+    static void Deallocate(void* address, size_t size) {
+        NodePool* pool = NodePool::ForSize(size, HUGE_PAGES);
+        if (pool != nullptr)
+            pool->Free(address);
+        else
+            ::operator delete(address);
+    }
+
+    template<typename N, typename... ARGS>
+    static typename RECLAIM::template Ptr<N> Make(ARGS&&... args) {
+        return MakeNode<PooledReclaim, N>(integral_constant<bool, RECLAIM::kOwnsNodes>(), std::forward<ARGS>(args)...);
+    }
+};
+
+#endif //LOCKFREE_POOL_H
@@ -0,0 +1,147 @@
+#ifndef LOCKFREE_QUEUE_H
+#define LOCKFREE_QUEUE_H
+
+#include <cstdint>
+
+#include "lockfree_backoff.h"
+#include "lockfree_counter.h"
+#include "lockfree_layout.h"
+#include "lockfree_node.h"
+#include "lockfree_reclaim.h"
+
+using namespace std;
+
+/**
+ * Multi-producer multi-consumer FIFO queue (Michael & Scott) on LockFreeNode.
+ * head_ points to a dummy node, the first item is the node after it; a dequeue copies that item and makes its node
+ * the new dummy, so producers and consumers never CAS the same word unless the queue is empty.
+ * tail_ may lag one node behind the last one, every operation which sees it lagging swings it forward first.
+ * An enqueue is one link CAS plus one tail CAS, a dequeue one head CAS, a failed CAS means another operation succeeded.
+ * Unlike PopHead of the lists, any number of threads may enqueue and dequeue concurrently with every node type and
+ * reclamation policy. T must be default constructible for the dummy node.
+ * COUNTER, LAYOUT and BACKOFF are the policies of the lists, PaddedLayout keeps head_ and tail_ on separate cache lines.
+ */
+template<typename T, typename RECLAIM = SharedPtrReclaim, typename COUNTER = ExactCounter,
+         typename LAYOUT = CompactLayout, typename BACKOFF = NoBackoff>
+class LockFreeQueue {
+public:
+    using NodeType = LockFreeNode<T, RECLAIM>;
+    using NodePtr = typename RECLAIM::template Ptr<NodeType>;
+    using Guard = typename RECLAIM::Guard;
+
+    LockFreeQueue() {
+        NodePtr dummy = RECLAIM::template Make<NodeType>();
+        head_.Store(dummy);
+        tail_.Store(dummy);
+    }
+
+    virtual ~LockFreeQueue() {
+        NodePtr node = head_.Load();
+        while (node != nullptr) {
+            NodePtr nextNode = node->next_.Load();
+            if (RECLAIM::kOwnsNodes)
+                RECLAIM::Destroy(node);
+            else
+                node->SetNext(nullptr); // release the shared_ptr chain one node at a time, not recursively
+            node = nextNode;
+        }
+    }
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    /**
+     * Appends a node at the tail of the queue, the queue takes it over.
+     *
+     * @param node The new node, not linked anywhere else.
+     */
+    void Enqueue(const NodePtr& node) {
+        Guard guard;
+        BACKOFF backoff;
+        node->SetNext(nullptr);
+        while (true) {
+            NodePtr last = tail_.Load();
+            NodePtr nextNode = last->next_.Load();
+            if (tail_.Peek() != last.get())
+                continue;
+            if (nextNode != nullptr) {
+                tail_.CompareAndSet(last, nextNode); // lagging tail
+                continue;
+            }
+            if (last->CompareAndSetNext(nullptr, node)) {
+                size_.Add(1);
+                tail_.CompareAndSet(last, node); // may fail, the next operation swings it
+                return;
+            }
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * Appends a copy of value in a node made by RECLAIM::Make.
+     */
+    void Enqueue(const T& value) {
+        Enqueue(RECLAIM::template Make<NodeType>(value));
+    }
+
+    /**
+     * Removes the item at the head of the queue.
+     *
+     * @param value Receives a copy of the removed item.
+     * @return True if an item was removed, false if the queue was empty.
+     */
+    bool TryDequeue(T& value) {
+        Guard guard;
+        BACKOFF backoff;
+        while (true) {
+            NodePtr first = head_.Load();
+            NodePtr last = tail_.Load();
+            NodePtr nextNode = first->next_.Load();
+            // first still the dummy: nextNode is not dequeued yet, so it is still protected and readable
+            if (head_.Peek() != first.get())
+                continue;
+            if (nextNode == nullptr)
+                return false;
+            if (first == last) {
+                tail_.CompareAndSet(last, nextNode); // the tail never falls behind the head
+                continue;
+            }
+            value = nextNode->data_;
+            if (head_.CompareAndSet(first, nextNode)) {
+                size_.Add(-1);
+                retire(first, nextNode);
+                return true;
+            }
+            backoff.Wait();
+        }
+    }
+
+    /**
+     * @return True if the queue had no item when it was looked at.
+     */
+    bool Empty() const {
+        Guard guard;
+        return head_.Load()->next_.Peek() == nullptr;
+    }
+
+    int64_t Size() const {
+        return size_.Get();
+    }
+
+protected:
+    typename LAYOUT::template Slot<typename RECLAIM::template Link<NodeType>> head_;
+    typename LAYOUT::template Slot<typename RECLAIM::template Link<NodeType>> tail_;
+    typename LAYOUT::template Slot<COUNTER> size_;
+
+    /**
+     * The old dummy is retired once head_ moved past it. A shared_ptr dummy still held by a slow thread would keep
+     * every later dummy alive through next_, Delete cuts the chain; the slow thread then sees head_ moved and retries.
+     */
+    void retire(const NodePtr& oldDummy, const NodePtr& nextNode) {
+        if (!RECLAIM::kOwnsNodes)
+            oldDummy->Delete(nextNode);
+        RECLAIM::Retire(oldDummy);
+    }
+};
+
+#endif //LOCKFREE_QUEUE_H
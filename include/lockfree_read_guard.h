@@ -0,0 +1,61 @@
+#ifndef LOCKFREE_READ_GUARD_H
+#define LOCKFREE_READ_GUARD_H
+
+/**
+ * Scoped read access to a lock-free list with borrowed node pointers: Head, Tail, Next and Prev return a
+ * const NODE* which stays readable until the guard is destroyed, whatever happens to the node in the list meanwhile.
+ * The steps are those of GetNext and GetPrev, deleted nodes are skipped as by the iterators.
+ * The guard is one RECLAIM::Guard and the pointers are just loaded, a reader writes nothing but its own epoch record.
+ * It needs a RECLAIM whose Guard protects every loaded node (kGuardProtects, EpochReclaim): the other policies
+ * protect a node only by its handle, a guard would have to keep one handle per node handed out, without bound.
+ * A guard belongs to the thread which created it and does not modify the list.
+ */
+template<typename LIST, typename RECLAIM>
+class LockFreeReadGuard {
+    static_assert(RECLAIM::kGuardProtects,
+                  "a read guard borrows raw pointers, it needs a RECLAIM whose Guard protects them, use EpochReclaim");
+
+public:
+    using NodeType = typename LIST::NodeType;
+    using NodePtr = typename LIST::NodePtr;
+
+    explicit LockFreeReadGuard(LIST& list) : list_(list) {}
+
+    LockFreeReadGuard(const LockFreeReadGuard&) = delete;
+    LockFreeReadGuard& operator=(const LockFreeReadGuard&) = delete;
+
+    const NodeType* Head() {
+        return list_.Head().get();
+    }
+
+    const NodeType* Tail() {
+        return list_.Tail().get();
+    }
+
+    /**
+     * @param node A node borrowed from this guard.
+     * @return The next valid node, nullptr at the end of the list.
+     */
+    const NodeType* Next(const NodeType* node) {
+        return node != nullptr ? list_.GetNext(handle(node)).get() : nullptr;
+    }
+
+    /**
+     * @param node A node borrowed from this guard.
+     * @return The previous valid node, nullptr at the head of the list.
+     */
+    const NodeType* Prev(const NodeType* node) {
+        return node != nullptr ? list_.GetPrev(handle(node)).get() : nullptr;
+    }
+
+private:
+    LIST& list_;
+    typename RECLAIM::Guard guard_;
+
+    // The Guard keeps the node readable, a plain handle to it is enough to step from it
+    static NodePtr handle(const NodeType* node) {
+        return RECLAIM::template Unmanaged<NodeType>(const_cast<NodeType*>(node));
+    }
+};
+
+#endif //LOCKFREE_READ_GUARD_H
@@ -0,0 +1,200 @@
+#ifndef LOCKFREE_RECLAIM_H
+#define LOCKFREE_RECLAIM_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+/**
+ * A reclamation policy decides how nodes are linked and when a removed node may be freed.
+ * Every policy provides:
+ *   Ptr<N>               the handle type returned by Head()/Tail()/GetNext()/... and accepted by Insert/Remove.
+ *   Link<N>              the atomic storage used for next_/prev_/head_/tail_, with Load/Peek/Store/CompareAndSet
+ *                        and Hint, a raw pointer for prefetching only (nullptr if it can not be read cheaply).
+ *   Cast<To>(p)          static cast between node handles (LockFreeBiNode <-> LockFreeNode).
+ *   Unmanaged(p)         a handle to a node that is never freed (the deletion sentinel).
+ *   Retire(p)            called once a node is unlinked by Remove/PopHead/PopTail.
+ *   Destroy(p)           called by the list destructor for every node still linked when kOwnsNodes is true.
+ *   Guard                scoped object held by every list operation, a caller may hold one around several operations
+ *                        to keep the returned nodes readable (see EpochReclaim).
+ *   kGuardProtects       true if every node loaded under a Guard stays readable until the Guard is destroyed, so
+ *                        a raw pointer may stand in for the handle (LockFreeReadGuard requires it).
+ *   Allocate/Deallocate  the memory of the nodes, the operator new/delete of the node types call them.
+ *   Make<N>(args...)     creates a node and returns its handle.
+ */
+
+/**
+ * Guard of the policies which need no critical section.
+ */
+struct NoReclaimGuard {
+    NoReclaimGuard() {}
+};
+
+/**
+ * Node memory from the heap, the allocation of every policy unless it is wrapped by PooledReclaim (lockfree_pool.h).
+ */
+struct HeapAllocation {
+    static void* Allocate(size_t size) {
+        return ::operator new(size);
+    }
+
+    static void Deallocate(void* address, size_t) {
+        ::operator delete(address);
+    }
+};
+
+/**
+ * Standard allocator on the Allocate/Deallocate of a policy, e.g. for allocate_shared.
+ */
+template<typename T, typename RECLAIM>
+struct ReclaimAllocator {
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = ReclaimAllocator<U, RECLAIM>;
+    };
+
+    ReclaimAllocator() {}
+
+    template<typename U>
+    ReclaimAllocator(const ReclaimAllocator<U, RECLAIM>&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(RECLAIM::Allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* address, size_t count) {
+        RECLAIM::Deallocate(address, count * sizeof(T));
+    }
+};
+
+template<typename T, typename U, typename RECLAIM>
+bool operator==(const ReclaimAllocator<T, RECLAIM>&, const ReclaimAllocator<U, RECLAIM>&) {
+    return true;
+}
+
+template<typename T, typename U, typename RECLAIM>
+bool operator!=(const ReclaimAllocator<T, RECLAIM>&, const ReclaimAllocator<U, RECLAIM>&) {
+    return false;
+}
+
+/**
+ * Make of the allocation wrappers of a policy (PooledReclaim, CacheAlignedReclaim), the memory comes from
+ * POLICY::Allocate. Tag dispatch on POLICY::kOwnsNodes: a shared_ptr node shares its block with its control block,
+ * a node owned by the list is created by the operator new of the node type, which calls POLICY::Allocate too.
+ */
+template<typename POLICY, typename N, typename... ARGS>
+typename POLICY::template Ptr<N> MakeNode(false_type, ARGS&&... args) {
+    return allocate_shared<N>(ReclaimAllocator<N, POLICY>(), std::forward<ARGS>(args)...);
+}
+
+template<typename POLICY, typename N, typename... ARGS>
+typename POLICY::template Ptr<N> MakeNode(true_type, ARGS&&... args) {
+    return typename POLICY::template Ptr<N>(new N(std::forward<ARGS>(args)...));
+}
+
+/**
+ * Default policy: nodes are owned by shared_ptr and links are accessed through atomic_load/atomic_store,
+ * so a removed node lives as long as someone still references it.
+ */
+struct SharedPtrReclaim : HeapAllocation {
+    static const bool kOwnsNodes = false;
+    static const bool kGuardProtects = false;
+
+    using Guard = NoReclaimGuard;
+
+    template<typename N>
+    using Ptr = shared_ptr<N>;
+
+    template<typename N>
+    class Link {
+    public:
+        Link() {}
+
+        Ptr<N> Load() const {
+            return atomic_load(&ptr_);
+        }
+
+        N* Peek() const {
+            return atomic_load(&ptr_).get();
+        }
+
+        // a shared_ptr can not be read without the lock of atomic_load, no prefetch for this policy
+        N* Hint() const {
+            return nullptr;
+        }
+
+        void Store(const Ptr<N>& node) {
+            atomic_store(&ptr_, node);
+        }
+
+        bool CompareAndSet(Ptr<N> expected, const Ptr<N>& desired) {
+            return atomic_compare_exchange_strong(&ptr_, &expected, desired);
+        }
+
+    private:
+        shared_ptr<N> ptr_;
+    };
+
+    template<typename To, typename From>
+    static Ptr<To> Cast(const Ptr<From>& node) {
+        return static_pointer_cast<To>(node);
+    }
+
+    template<typename N>
+    static Ptr<N> Unmanaged(N* node) {
+        return shared_ptr<N>(node, [](N *) {});
+    }
+
+    template<typename N, typename... ARGS>
+    static Ptr<N> Make(ARGS&&... args) {
+        return make_shared<N>(std::forward<ARGS>(args)...);
+    }
+
+    template<typename N>
+    static void Retire(const Ptr<N>&) {}
+
+    template<typename N>
+    static void Destroy(const Ptr<N>&) {}
+};
+
+/**
+ * Link storing a raw pointer, shared by the policies which manage node lifetime themselves.
+ * PROTECT turns the loaded raw pointer into the policy's handle type.
+ */
+template<typename N, typename PTR>
+class RawLink {
+public:
+    RawLink() : ptr_(nullptr) {}
+
+    PTR Load() const {
+        return PTR::Protect(ptr_);
+    }
+
+    N* Peek() const {
+        return ptr_.load();
+    }
+
+    N* Hint() const {
+        return ptr_.load(memory_order_relaxed);
+    }
+
+    void Store(const PTR& node) {
+        ptr_.store(node.get());
+    }
+
+    bool CompareAndSet(const PTR& expected, const PTR& desired) {
+        N* oldNode = expected.get();
+        return ptr_.compare_exchange_strong(oldNode, desired.get());
+    }
+
+private:
+    atomic<N*> ptr_;
+};
+
+#endif //LOCKFREE_RECLAIM_H
@@ -2,67 +2,41 @@
 #define LOCKFREE_SINGLE_LIST_H__
 
 #include "lockfree_node.h"
+#include "lockfree_hook.h"
 #include "lockfree_list.h"
+#include "lockfree_marked_list.h"
+
+/**
+ * NODE switches the deletion scheme: LockFreeNode (default) deletes by linking the dummyNode sentinel,
+ * LockFreeMarkedNode marks next_ and keeps the successor (see lockfree_marked_list.h),
+ * LockFreeIntrusiveNode links the objects of a T deriving from LockFreeHook directly (see lockfree_hook.h).
+ * LAYOUT places the control words of the list, see lockfree_layout.h. BACKOFF paces the retries after a failed CAS,
+ * see lockfree_backoff.h. STATS counts the contention inside the list, see lockfree_stats.h.
+ */
+template<typename T, typename RECLAIM = SharedPtrReclaim, template<typename, typename> class NODE = LockFreeNode,
+         typename COUNTER = ExactCounter, typename LAYOUT = CompactLayout, typename BACKOFF = NoBackoff,
+         typename STATS = NoStats>
+class LockFreeSiList
+    : public LockFreeList<NODE<T, RECLAIM>, RECLAIM, COUNTER, LAYOUT, BACKOFF, STATS,
+                          LockFreeSiList<T, RECLAIM, NODE, COUNTER, LAYOUT, BACKOFF, STATS>> {
+    using Base = LockFreeList<NODE<T, RECLAIM>, RECLAIM, COUNTER, LAYOUT, BACKOFF, STATS, LockFreeSiList>;
+    friend Base;
+
+public:
+    using NodePtr = typename Base::NodePtr;
 
-template<typename T>
-class LockFreeSiList : public LockFreeList<LockFreeNode<T>> {
 protected:
-    void deleteNodeBetween(shared_ptr<LockFreeNode<T>> node, shared_ptr<LockFreeNode<T>> prevNode, shared_ptr<LockFreeNode<T>> nextNode) override {
-        shared_ptr<LockFreeNode<T>> actualNextNode = this->getValidNext(node); // maybe not same as origNextNode
-        if (actualNextNode == node)
-            actualNextNode = nullptr;
-        shared_ptr<LockFreeNode<T>> actualPrevNode = getValidPrev(node);
-        bool result;
-        if (actualPrevNode != nullptr) {
-            result = this->updateNext(actualPrevNode, actualNextNode);
-        } else {
-            result = this->updateHead(this->Head(), actualNextNode);
-        }
-
-        if (actualNextNode == nullptr) {
-            this->updateTail(this->Tail(), actualPrevNode);
-        }
-        if (actualPrevNode != nullptr || actualNextNode != nullptr) {
-            if (!result || actualPrevNode != prevNode || actualNextNode != nextNode)
-                fixDelete(prevNode, nextNode);
-        }
-    }
-
-    bool isWrongConnection(shared_ptr<LockFreeNode<T>> node, shared_ptr<LockFreeNode<T>> nextNode) override {
+    bool isWrongConnection(const NodePtr& node, const NodePtr& nextNode) {
         return node->Next() != nextNode;
     }
+};
 
-    shared_ptr<LockFreeNode<T>> getValidPrev(shared_ptr<LockFreeNode<T>> node) override {
-        if (nullptr == node)
-            return nullptr;
-        shared_ptr<LockFreeNode<T>> prevNode = this->Head();
-        while (nullptr != prevNode && prevNode->Next() != node && prevNode->isDeleted()) {
-            prevNode = prevNode->Next();
-        }
-        if (prevNode == node)
-            return nullptr;
-        return prevNode;
-    }
-
-    void fixDelete(shared_ptr<LockFreeNode<T>> prevNode, shared_ptr<LockFreeNode<T>> nextNode) {
-        shared_ptr<LockFreeNode<T>> actualPrevNode = prevNode;
-        if (actualPrevNode != nullptr && actualPrevNode->isDeleted()) {
-            actualPrevNode = getValidPrev(prevNode);
-        }
-        shared_ptr<LockFreeNode<T>> actualNextNode = nextNode;
-        if (actualNextNode != nullptr && actualNextNode->isDeleted()) {
-            actualNextNode = this->getValidNext(nextNode);
-        }
-
-        if (actualPrevNode == nullptr)
-            this->updateHead(actualNextNode);
-
-        if ((actualNextNode == nullptr || actualPrevNode == actualNextNode))
-            this->updateTail(actualPrevNode);
-        else if (actualPrevNode != nullptr && actualNextNode != nextNode) {
-            this->updateNext(actualPrevNode, actualNextNode);
-        }
-    }
+template<typename T, typename RECLAIM, typename COUNTER, typename LAYOUT, typename BACKOFF, typename STATS>
+class LockFreeSiList<T, RECLAIM, LockFreeMarkedNode, COUNTER, LAYOUT, BACKOFF, STATS>
+    : public LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER, LAYOUT, BACKOFF, STATS> {
+public:
+    using NodePtr =
+        typename LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER, LAYOUT, BACKOFF, STATS>::NodePtr;
 };
 
 #endif /* LOCK_FREE_BILIST_H__ */
@@ -0,0 +1,250 @@
+#ifndef LOCKFREE_SKIP_LIST_H
+#define LOCKFREE_SKIP_LIST_H
+
+#include <functional>
+
+#include "lockfree_skip_node.h"
+#include "lockfree_marked_list.h"
+
+/**
+ * Lock-free skip list map (Herlihy-Shavit), unique keys ordered by COMPARE.
+ * Level 0 is the LockFreeMarkedList of the base, so Head, GetNext, begin/end, Size and CheckConsistence
+ * work on it as on LockFreeSiList<T, SharedPtrReclaim, LockFreeMarkedNode>. The upper levels are shortcuts:
+ * Find, Insert and Remove are O(log n) expected.
+ * Remove marks the upper levels of the node top-down, then level 0, whose mark deletes the node.
+ * A search unlinks every marked node it meets. The unordered inserts, Emplace included, and removals of the base
+ * are hidden.
+ */
+template<typename K, typename V, typename COMPARE = less<K>, typename COUNTER = ExactCounter>
+class LockFreeSkipList : public LockFreeMarkedList<LockFreeSkipNode<K, V>, SharedPtrReclaim, COUNTER> {
+public:
+    using NodeType = LockFreeSkipNode<K, V>;
+    using NodePtr = typename LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::NodePtr;
+
+    LockFreeSkipList(const COMPARE& compare = COMPARE()) : compare_(compare), height_(1) {}
+
+    // The upper levels are shortcut chains of their own, they are cleared before the base unlinks level 0
+    ~LockFreeSkipList() {
+        for (NodePtr node = this->sentinel_; node != nullptr; node = this->nextOf(node)) {
+            for (int level = 1; level < node->Height(); level++)
+                node->NextAt(level).set(nullptr, false);
+        }
+    }
+
+    /**
+     * Inserts a node at its sorted position.
+     *
+     * @param node The new node, its height is fixed by its constructor.
+     * @return True if the node is inserted, false if its key exists.
+     */
+    bool Insert(const NodePtr& node) {
+        const K& key = node->Key();
+        int height = node->Height();
+        NodePtr preds[NodeType::kMaxHeight];
+        NodePtr succs[NodeType::kMaxHeight];
+        raiseHeight(height);
+        while (true) {
+            if (search(key, preds, succs))
+                return false;
+            for (int level = 0; level < height; level++)
+                node->NextAt(level).set(succs[level], false);
+            if (!preds[0]->NextAt(0).compareAndSet(succs[0], node, false, false))
+                continue;
+            this->size_.Add(1);
+            break;
+        }
+
+        // the node is in the map now, the upper levels are shortcuts linked bottom-up
+        for (int level = 1; level < height; level++) {
+            while (true) {
+                auto next = node->NextAt(level).get();
+                if (next.second)
+                    return true; // removed meanwhile, stop linking
+                if (next.first != succs[level] && !node->NextAt(level).compareAndSet(next.first, succs[level], false, false))
+                    continue;
+                if (preds[level]->NextAt(level).compareAndSet(succs[level], node, false, false))
+                    break;
+                if (!search(key, preds, succs) || succs[0] != node)
+                    return true;
+            }
+        }
+        // a Remove which marked the node before the last link above missed that link, unlink it again
+        if (node->isDeleted())
+            search(key, preds, succs);
+        return true;
+    }
+
+    bool Insert(const K& key, const V& value) {
+        return Insert(make_shared<NodeType>(key, value));
+    }
+
+    /**
+     * Looks the key up without writing to the list.
+     * @return The node of key, nullptr if the key is not in the map.
+     */
+    NodePtr Find(const K& key) const {
+        NodePtr node = lowerBound(key);
+        if (node == nullptr || compare_(key, node->Key()))
+            return nullptr;
+        return node;
+    }
+
+    bool Contains(const K& key) const {
+        return Find(key) != nullptr;
+    }
+
+    /**
+     * @return The first node whose key is not less than key, nullptr if every key is less.
+     */
+    NodePtr LowerBound(const K& key) const {
+        return lowerBound(key);
+    }
+
+    /**
+     * Removes the node of key.
+     * @return The removed node, nullptr if the key is not in the map or another thread removed it first.
+     */
+    NodePtr Remove(const K& key) {
+        NodePtr preds[NodeType::kMaxHeight];
+        NodePtr succs[NodeType::kMaxHeight];
+        if (!search(key, preds, succs))
+            return nullptr;
+        NodePtr victim = succs[0];
+        for (int level = victim->Height() - 1; level > 0; level--) {
+            auto next = victim->NextAt(level).get();
+            while (!next.second) {
+                victim->NextAt(level).compareAndSet(next.first, next.first, false, true);
+                next = victim->NextAt(level).get();
+            }
+        }
+        while (true) {
+            auto next = victim->NextAt(0).get();
+            if (next.second)
+                return nullptr;
+            if (victim->NextAt(0).compareAndSet(next.first, next.first, false, true)) {
+                this->size_.Add(-1);
+                search(key, preds, succs); // unlinks the victim from every level
+                return victim;
+            }
+        }
+    }
+
+    /**
+     * Visits the nodes with from <= key < to in order, weakly consistent like the iterators.
+     *
+     * @param func Called with every node, returns false to stop the scan.
+     * @return The number of visited nodes.
+     */
+    template<typename FUNC>
+    size_t Scan(const K& from, const K& to, FUNC func) {
+        size_t count = 0;
+        for (NodePtr node = lowerBound(from); node != nullptr && compare_(node->Key(), to); node = this->GetNext(node)) {
+            count++;
+            if (!func(node))
+                break;
+        }
+        return count;
+    }
+
+    /**
+     * This function is used for testing only, it only works in thread-safe mode.
+     * Checks that every level is sorted and only links nodes of level 0, then the base checks of level 0.
+     */
+    bool CheckConsistence(int64_t count = -1) {
+        for (int level = NodeType::kMaxHeight - 1; level >= 0; level--) {
+            NodePtr prevNode = nullptr;
+            for (NodePtr node = nextAt(this->sentinel_, level); node != nullptr; node = nextAt(node, level)) {
+                if (prevNode != nullptr && !compare_(prevNode->Key(), node->Key())) {
+                    std::cout << "fatal: " << node.get() << " is out of order at level " << level << endl;
+                    return false;
+                }
+                if (node->isDeleted()) {
+                    std::cout << "fatal: " << node.get() << " is deleted at level " << level << endl;
+                    return false;
+                }
+                prevNode = node;
+            }
+        }
+        return LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::CheckConsistence(count);
+    }
+
+private:
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::InsertHead;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::Append;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::InsertHeadChain;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::AppendChain;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::PopHead;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::PopTail;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::PopHeadN;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::DrainAll;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::Emplace;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::EmplaceHead;
+    using LockFreeMarkedList<NodeType, SharedPtrReclaim, COUNTER>::EmplaceBefore;
+
+    COMPARE compare_;
+    atomic<int> height_;  // the levels in use, searches start below it instead of at kMaxHeight
+
+    void raiseHeight(int height) {
+        int current = height_.load(memory_order_relaxed);
+        while (current < height && !height_.compare_exchange_weak(current, height, memory_order_relaxed)) {}
+    }
+
+    static NodePtr nextAt(const NodePtr& node, int level) {
+        return SharedPtrReclaim::Cast<NodeType>(node->NextAt(level).getPtr());
+    }
+
+    // Read only descent, a marked node still links its successor so it is stepped over
+    NodePtr lowerBound(const K& key) const {
+        NodePtr prevNode = this->sentinel_;
+        NodePtr node;
+        for (int level = height_.load(memory_order_relaxed) - 1; level >= 0; level--) {
+            node = nextAt(prevNode, level);
+            while (node != nullptr) {
+                auto next = node->NextAt(level).get();
+                if (!next.second) {
+                    if (!compare_(node->Key(), key))
+                        break;
+                    prevNode = node;
+                }
+                node = SharedPtrReclaim::Cast<NodeType>(next.first);
+            }
+        }
+        return node;
+    }
+
+    /**
+     * Fills preds and succs with the unmarked nodes around key at every level, unlinking marked nodes on the way,
+     * restarts from the top if an unlink fails.
+     * @return True if succs[0] holds key.
+     */
+    bool search(const K& key, NodePtr* preds, NodePtr* succs) const {
+        while (!trySearch(key, preds, succs)) {}
+        return succs[0] != nullptr && !compare_(key, succs[0]->Key());
+    }
+
+    bool trySearch(const K& key, NodePtr* preds, NodePtr* succs) const {
+        NodePtr prevNode = this->sentinel_;
+        for (int level = height_.load(memory_order_relaxed) - 1; level >= 0; level--) {
+            NodePtr node = nextAt(prevNode, level);
+            while (node != nullptr) {
+                auto next = node->NextAt(level).get();
+                NodePtr nextNode = SharedPtrReclaim::Cast<NodeType>(next.first);
+                if (next.second) {
+                    if (!prevNode->NextAt(level).compareAndSet(node, nextNode, false, false))
+                        return false;
+                    node = nextNode;
+                } else if (compare_(node->Key(), key)) {
+                    prevNode = node;
+                    node = nextNode;
+                } else {
+                    break;
+                }
+            }
+            preds[level] = prevNode;
+            succs[level] = node;
+        }
+        return true;
+    }
+};
+
+#endif //LOCKFREE_SKIP_LIST_H
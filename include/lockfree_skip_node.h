@@ -0,0 +1,66 @@
+#ifndef LOCKFREE_SKIP_NODE_H
+#define LOCKFREE_SKIP_NODE_H
+
+#include <functional>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lockfree_marked_node.h"
+
+/**
+ * Skip list node: level 0 is the next_ of LockFreeMarkedNode, so the bottom level is a plain marked list,
+ * levels 1..Height()-1 are marked links of their own. data_ holds the key and the value.
+ * A node is deleted once its level 0 link is marked, the upper marks only stop further linking.
+ */
+template<typename K, typename V>
+struct LockFreeSkipNode : LockFreeMarkedNode<pair<K, V>> {
+    using MarkedNode = LockFreeMarkedNode<pair<K, V>>;
+    using Link = MarkedAtomic<MarkedNode>;
+
+    static const int kMaxHeight = 24;
+
+    // The sentinel of a skip list, it has every level
+    LockFreeSkipNode() : upper_(kMaxHeight - 1) {}
+
+    LockFreeSkipNode(const K& key, const V& value)
+        : MarkedNode(pair<K, V>(key, value)), upper_(RandomHeight() - 1) {}
+
+    LockFreeSkipNode(const K& key, const V& value, int height)
+        : MarkedNode(pair<K, V>(key, value)), upper_(height - 1) {}
+
+    const K& Key() const {
+        return this->data_.first;
+    }
+
+    V& Value() {
+        return this->data_.second;
+    }
+
+    int Height() const {
+        return static_cast<int>(upper_.size()) + 1;
+    }
+
+    Link& NextAt(int level) {
+        return level == 0 ? this->next_ : upper_[level - 1];
+    }
+
+    // Geometric height with p = 1/2, capped at kMaxHeight
+    static int RandomHeight() {
+        static thread_local std::minstd_rand linearRand(
+                static_cast<unsigned>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+        unsigned bits = linearRand();
+        int height = 1;
+        while ((bits & 1) != 0 && height < kMaxHeight) {
+            bits >>= 1;
+            height++;
+        }
+        return height;
+    }
+
+private:
+    std::vector<Link> upper_;
+};
+
+#endif //LOCKFREE_SKIP_NODE_H
@@ -0,0 +1,168 @@
+#ifndef LOCKFREE_SORTED_LIST_H
+#define LOCKFREE_SORTED_LIST_H
+
+#include <functional>
+
+#include "lockfree_marked_node.h"
+#include "lockfree_marked_list.h"
+
+/**
+ * Ordered set on the Harris-Michael list: the nodes are kept sorted by COMPARE on their data_,
+ * a key is found, inserted or removed with one search pass from the sentinel.
+ * Updates unlink the marked nodes met on the way, lookups step over them without writing.
+ * The nodes are LockFreeMarkedNode, the default deletion scheme loses the successor of a deleted node
+ * and can not search in one pass.
+ * The unordered InsertHead/Append/Insert, their Emplace forms and the chain inserts of the base are hidden, everything
+ * else (Remove, PopHead, GetNext, begin/end...) works as on LockFreeSiList<T, SharedPtrReclaim, LockFreeMarkedNode>.
+ */
+template<typename T, typename COMPARE = less<T>, typename RECLAIM = SharedPtrReclaim, typename COUNTER = ExactCounter>
+class LockFreeSortedList : public LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER> {
+public:
+    using NodePtr = typename LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::NodePtr;
+    using Guard = typename RECLAIM::Guard;
+
+    LockFreeSortedList(const COMPARE& compare = COMPARE()) : compare_(compare) {}
+
+    /**
+     * Inserts a node at its sorted position, equal nodes keep their insertion order.
+     *
+     * @param node The new node to be inserted.
+     * @param unique Reject the node if a node with an equal key is in the list.
+     * @return True if the node is inserted, false if unique is set and the key exists.
+     */
+    bool InsertSorted(const NodePtr& node, bool unique=true) {
+        Guard guard;
+        const T& key = node->data_;
+        while (true) {
+            NodePtr prevNode;
+            NodePtr nextNode;
+            if (unique) {
+                nextNode = seek([&](const T& data) { return compare_(data, key); }, prevNode);
+                if (nextNode != nullptr && !compare_(key, nextNode->data_))
+                    return false;
+            } else {
+                nextNode = seek([&](const T& data) { return !compare_(key, data); }, prevNode);
+            }
+            node->SetNext(nextNode);
+            if (prevNode->CompareAndSetNext(nextNode, node)) {
+                this->size_.Add(1);
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @return The first node equal to key, nullptr if there is none.
+     */
+    NodePtr Find(const T& key) const {
+        Guard guard;
+        NodePtr node = lowerBound(key);
+        if (node == nullptr || compare_(key, node->data_))
+            return nullptr;
+        return node;
+    }
+
+    bool Contains(const T& key) const {
+        return Find(key) != nullptr;
+    }
+
+    /**
+     * @return The first node not less than key, nullptr if every node is less.
+     */
+    NodePtr LowerBound(const T& key) const {
+        Guard guard;
+        return lowerBound(key);
+    }
+
+    /**
+     * Removes the first node equal to key.
+     *
+     * @param key The key to be removed.
+     * @return The removed node, nullptr if no node equals key.
+     */
+    NodePtr RemoveKey(const T& key) {
+        Guard guard;
+        while (true) {
+            NodePtr prevNode;
+            NodePtr node = seek([&](const T& data) { return compare_(data, key); }, prevNode);
+            if (node == nullptr || compare_(key, node->data_))
+                return nullptr;
+            if (this->Remove(node, prevNode, false))
+                return node;
+        }
+    }
+
+    /**
+     * This function is used for testing only, it only works in thread-safe mode.
+     * @return True if the list is consistent and sorted, false otherwise.
+     */
+    bool CheckConsistence(int64_t count = -1) {
+        Guard guard;
+        NodePtr prevNode = nullptr;
+        for (NodePtr node = this->nextOf(this->sentinel_); node != nullptr; node = this->nextOf(node)) {
+            if (prevNode != nullptr && compare_(node->data_, prevNode->data_)) {
+                std::cout << "fatal: " << node.get() << " is out of order" << endl;
+                return false;
+            }
+            prevNode = node;
+        }
+        return LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::CheckConsistence(count);
+    }
+
+private:
+    using LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::InsertHead;
+    using LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::Append;
+    using LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::InsertHeadChain;
+    using LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::AppendChain;
+    using LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::Insert;
+    using LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::Emplace;
+    using LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::EmplaceHead;
+    using LockFreeMarkedList<LockFreeMarkedNode<T, RECLAIM>, RECLAIM, COUNTER>::EmplaceBefore;
+
+    COMPARE compare_;
+
+    // Read only walk, a marked node still links its successor so it is stepped over
+    NodePtr lowerBound(const T& key) const {
+        NodePtr node = this->nextOf(this->sentinel_);
+        while (node != nullptr) {
+            auto next = node->next_.get();
+            if (!next.second && !compare_(node->data_, key))
+                return node;
+            node = RECLAIM::template Cast<LockFreeMarkedNode<T, RECLAIM>>(next.first);
+        }
+        return nullptr;
+    }
+
+    /**
+     * Returns the first unmarked node whose data_ is not before the key, nullptr for the end of the list,
+     * and unlinks every marked node on the way with one CAS on its predecessor.
+     *
+     * @param before Tells whether a data_ sorts before the key.
+     * @param prevNode Set to the unmarked node right before the returned node, the sentinel for the first one.
+     */
+    template<typename BEFORE>
+    NodePtr seek(BEFORE before, NodePtr& prevNode) const {
+        prevNode = this->sentinel_;
+        NodePtr node = this->nextOf(prevNode);
+        while (node != nullptr) {
+            auto next = node->next_.get();
+            NodePtr nextNode = RECLAIM::template Cast<LockFreeMarkedNode<T, RECLAIM>>(next.first);
+            if (!next.second) {
+                if (!before(node->data_))
+                    return node;
+                prevNode = node;
+                node = nextNode;
+            } else if (prevNode->CompareAndSetNext(node, nextNode)) {
+                node = nextNode;
+            } else if (prevNode->isDeleted()) {
+                prevNode = this->sentinel_;
+                node = this->nextOf(prevNode);
+            } else {
+                node = this->nextOf(prevNode);
+            }
+        }
+        return nullptr;
+    }
+};
+
+#endif //LOCKFREE_SORTED_LIST_H
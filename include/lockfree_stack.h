@@ -0,0 +1,118 @@
+#ifndef LOCKFREE_STACK_H
+#define LOCKFREE_STACK_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "lockfree_backoff.h"
+#include "lockfree_layout.h"
+#include "lockfree_silist.h"
+
+/**
+ * LIFO stack with elimination backoff (Hendler, Shavit & Yerushalmi) on the marked LockFreeSiList.
+ * Push and Pop try the head of the list once; after a failed CAS a pusher offers its node in a random slot of the
+ * elimination array and waits up to WINDOW spins, a popper polls random slots as long. A pop taking an offered node
+ * completes both operations without touching the head, so under symmetric push/pop contention the colliding pairs
+ * cancel out in the array, and only the threads which found no partner retry on the list.
+ * A push and the pop which took its node are linearized at the take, one after the other; Pop returns nullptr only
+ * when it found the list empty, it never waits for a push.
+ * SLOTS is the size of the elimination array, every slot on cache lines of its own.
+ * InsertHead, PopHead, the Emplace inserts and the operations at the tail or in the middle of the list are hidden,
+ * InsertHeadChain, PopHeadN, DrainAll, Remove and the iterators work as on LockFreeSiList<T, RECLAIM, LockFreeMarkedNode>.
+ */
+template<typename T, typename RECLAIM = SharedPtrReclaim, typename COUNTER = ExactCounter,
+         typename LAYOUT = CompactLayout, size_t SLOTS = 8, uint32_t WINDOW = 256>
+class LockFreeStack : public LockFreeSiList<T, RECLAIM, LockFreeMarkedNode, COUNTER, LAYOUT> {
+    using Base = LockFreeSiList<T, RECLAIM, LockFreeMarkedNode, COUNTER, LAYOUT>;
+
+public:
+    using NodeType = LockFreeMarkedNode<T, RECLAIM>;
+    using NodePtr = typename Base::NodePtr;
+    using Guard = typename RECLAIM::Guard;
+
+    LockFreeStack() {
+        taken_ = RECLAIM::template Unmanaged<NodeType>(&takenNode_);
+    }
+
+    /**
+     * Pushes a node on the top of the stack, or hands it to a concurrent Pop.
+     */
+    void Push(const NodePtr& node) {
+        Guard guard;
+        while (!Base::InsertHead(node, false)) {
+            if (offer(node))
+                return;
+        }
+    }
+
+    /**
+     * @return The node on the top of the stack or the node of a concurrent Push, nullptr if the stack is empty.
+     */
+    NodePtr Pop() {
+        Guard guard;
+        while (true) {
+            NodePtr head = this->Head();
+            if (head == nullptr)
+                return nullptr;
+            if (this->Remove(head, this->sentinel_, false))
+                return head;
+            NodePtr node = take();
+            if (node != nullptr)
+                return node;
+        }
+    }
+
+protected:
+    NodeType takenNode_;
+    // stored in a slot by the Pop which took the offered node, only the offering Push empties the slot again
+    NodePtr taken_;
+    CacheLinePadded<typename RECLAIM::template Link<NodeType>> slots_[SLOTS];
+
+    /**
+     * Offers node in a random slot for up to WINDOW spins.
+     * @return True if a Pop took the node, false if the slot was busy or nobody came.
+     */
+    bool offer(const NodePtr& node) {
+        auto& slot = slots_[BackoffRandom() % SLOTS];
+        node->SetNext(nullptr); // the next of the failed InsertHead would keep a list node alive
+        if (!slot.CompareAndSet(nullptr, node))
+            return false;
+        for (uint32_t i = 0; i < WINDOW && slot.Peek() == node.get(); i++)
+            CpuRelax();
+        if (slot.CompareAndSet(node, nullptr))
+            return false;
+        slot.Store(nullptr);
+        return true;
+    }
+
+    /**
+     * Polls random slots for up to WINDOW spins.
+     * @return The node taken from a Push, nullptr if none was offered.
+     */
+    NodePtr take() {
+        for (uint32_t i = 0; i < WINDOW; i++) {
+            auto& slot = slots_[BackoffRandom() % SLOTS];
+            NodeType* offered = slot.Peek();
+            if (offered != nullptr && offered != taken_.get()) {
+                NodePtr node = slot.Load();
+                if (node != nullptr && node != taken_ && slot.CompareAndSet(node, taken_))
+                    return node;
+            }
+            CpuRelax();
+        }
+        return nullptr;
+    }
+
+private:
+    using Base::InsertHead;
+    using Base::Append;
+    using Base::Insert;
+    using Base::Emplace;
+    using Base::EmplaceHead;
+    using Base::EmplaceBefore;
+    using Base::AppendChain;
+    using Base::PopHead;
+    using Base::PopTail;
+};
+
+#endif //LOCKFREE_STACK_H
@@ -0,0 +1,182 @@
+#ifndef LOCKFREE_STATS_H
+#define LOCKFREE_STATS_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "lockfree_layout.h"
+#include "lockfree_util.h"
+
+using namespace std;
+
+/**
+ * A statistics policy counts the contention inside a list. Every policy provides:
+ *   kEnabled            false if nothing is counted, the list code around the calls is then dead and compiled out.
+ *   Count(event)        called once per event, see ListEvent.
+ *   Walk(walk, steps)   called once per traversal with the number of nodes it stepped over, see ListWalk.
+ *   Snapshot()          the counts so far, as ListStats.
+ * The list calls them on a mutable member, so the const searches count too.
+ */
+
+enum class ListEvent : int {
+    kNextCasFailure, // the link CAS on next_ of an insertion or of an unlink failed
+    kHeadCasFailure, // the CAS on head_ or on the sentinel of the marked lists failed
+    kTailCasFailure, // the CAS on the tail_ hint failed
+    kAppendRetry,    // Append or AppendChain is about to retry
+    kInsertRetry,    // InsertHead, Insert or InsertHeadChain is about to retry
+    kRemoveRetry,    // Remove, PopHead or PopTail is about to retry
+    kFixInsert,      // an insertion found the prev_ behind it changed concurrently and searched it again
+    kFixDelete,      // an unlink lost the link into its node to a concurrent change and searched it again
+    kFixPrev,        // a prev_ of a bidirectional list was settled by a search from the head
+    kHelpUnlink,     // a search unlinked a node removed by another thread
+    kCount
+};
+
+enum class ListWalk : int {
+    kValidNext, // getValidNext, over deleted nodes
+    kValidPrev, // findPrev, the search of a predecessor
+    kLocate,    // locate, the search of the marked lists
+    kCount
+};
+
+inline const char* ListEventName(ListEvent event) {
+    static const char* names[] = {"next_cas_failure", "head_cas_failure", "tail_cas_failure",
+                                  "append_retry", "insert_retry", "remove_retry",
+                                  "fix_insert", "fix_delete", "fix_prev", "help_unlink"};
+    return names[static_cast<int>(event)];
+}
+
+inline const char* ListWalkName(ListWalk walk) {
+    static const char* names[] = {"valid_next", "valid_prev", "locate"};
+    return names[static_cast<int>(walk)];
+}
+
+/**
+ * The counts of a list at one point in time, plain values to export.
+ * The walks are counted in power of two buckets: bucket 0 holds the walks of no step, bucket b the walks of
+ * [2^(b-1), 2^b) steps, the last bucket every longer walk.
+ */
+struct ListStats {
+    static const int kEventCount = static_cast<int>(ListEvent::kCount);
+    static const int kWalkCount = static_cast<int>(ListWalk::kCount);
+    static const int kWalkBuckets = 16;
+
+    struct Walks {
+        uint64_t count;
+        uint64_t steps;
+        uint64_t buckets[kWalkBuckets];
+
+        double MeanSteps() const {
+            return count == 0 ? 0 : double(steps) / count;
+        }
+    };
+
+    uint64_t events[kEventCount];
+    Walks walks[kWalkCount];
+
+    uint64_t Count(ListEvent event) const {
+        return events[static_cast<int>(event)];
+    }
+
+    const Walks& Walk(ListWalk walk) const {
+        return walks[static_cast<int>(walk)];
+    }
+
+    static int WalkBucket(uint64_t steps) {
+        int bucket = 0;
+        while (steps != 0 && bucket < kWalkBuckets - 1) {
+            steps >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+};
+
+/**
+ * Default policy: nothing is counted and no instruction is left in the list, Snapshot() is all zeros.
+ */
+struct NoStats {
+    static const bool kEnabled = false;
+
+    void Count(ListEvent) {}
+
+    void Walk(ListWalk, uint64_t) {}
+
+    ListStats Snapshot() const {
+        return ListStats();
+    }
+};
+
+/**
+ * Per-thread counters on cache lines of their own, as ShardedCounter: an event touches the shard of its thread
+ * only, unless more than kShards threads use the list. Snapshot() sums the shards, so it is only exact while
+ * the list is not used concurrently. About 25 KB per list.
+ */
+class ContentionStats {
+public:
+    static const bool kEnabled = true;
+    static const int kShards = 32;
+
+    ContentionStats() {
+        for (Shard& shard : shards_) {
+            for (auto& event : shard.events)
+                event.store(0, memory_order_relaxed);
+            for (auto& walk : shard.walks) {
+                walk.count.store(0, memory_order_relaxed);
+                walk.steps.store(0, memory_order_relaxed);
+                for (auto& bucket : walk.buckets)
+                    bucket.store(0, memory_order_relaxed);
+            }
+        }
+    }
+
+    void Count(ListEvent event) {
+        shards_[threadShard()].events[static_cast<int>(event)].fetch_add(1, memory_order_relaxed);
+    }
+
+    void Walk(ListWalk walk, uint64_t steps) {
+        ShardWalks& walks = shards_[threadShard()].walks[static_cast<int>(walk)];
+        walks.count.fetch_add(1, memory_order_relaxed);
+        walks.steps.fetch_add(steps, memory_order_relaxed);
+        walks.buckets[ListStats::WalkBucket(steps)].fetch_add(1, memory_order_relaxed);
+    }
+
+    ListStats Snapshot() const {
+        ListStats stats = ListStats();
+        for (const Shard& shard : shards_) {
+            for (int i = 0; i < ListStats::kEventCount; i++)
+                stats.events[i] += shard.events[i].load(memory_order_relaxed);
+            for (int i = 0; i < ListStats::kWalkCount; i++) {
+                stats.walks[i].count += shard.walks[i].count.load(memory_order_relaxed);
+                stats.walks[i].steps += shard.walks[i].steps.load(memory_order_relaxed);
+                for (int b = 0; b < ListStats::kWalkBuckets; b++)
+                    stats.walks[i].buckets[b] += shard.walks[i].buckets[b].load(memory_order_relaxed);
+            }
+        }
+        return stats;
+    }
+
+private:
+    struct ShardWalks {
+        atomic<uint64_t> count;
+        atomic<uint64_t> steps;
+        atomic<uint64_t> buckets[ListStats::kWalkBuckets];
+    };
+
+    struct ShardCounts {
+        atomic<uint64_t> events[ListStats::kEventCount];
+        ShardWalks walks[ListStats::kWalkCount];
+    };
+
+    using Shard = CacheLinePadded<ShardCounts>;
+
+    Shard shards_[kShards];
+
+    static int threadShard() {
+        static atomic<int> nextShard(0);
+        static thread_local int shard = nextShard.fetch_add(1, memory_order_relaxed) % kShards;
+        return shard;
+    }
+};
+
+#endif //LOCKFREE_STATS_H
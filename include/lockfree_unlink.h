@@ -0,0 +1,107 @@
+#ifndef LOCKFREE_UNLINK_H
+#define LOCKFREE_UNLINK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "lockfree_reclaim.h"
+
+using namespace std;
+
+/**
+ * A list removes a node of the default deletion scheme by linking a tagged note as its next_ (LockFreeNode::Marker),
+ * the low bit tells the note from a node, both are at least pointer aligned.
+ */
+inline bool isUnlinkNote(const void* next) {
+    return (reinterpret_cast<uintptr_t>(next) & 1) != 0;
+}
+
+template<typename N>
+N* TagUnlinkNote(const void* note) {
+    return reinterpret_cast<N*>(reinterpret_cast<uintptr_t>(note) | 1);
+}
+
+/**
+ * The unlink notes of the default deletion scheme, see LockFreeList::unlinkRun.
+ * The remover of a node stores the successor of the node in a note of its own, then links the tagged note as
+ * next_ of the node with one CAS, so the successor is published together with the removal: a thread meeting the
+ * removed node reads it from the note and swings the link into the node over to it, instead of waiting for the
+ * remover, and tells the remover so through helped. Every thread owns kRunLength notes per node type, one per node of
+ * a run claimed at once, and reuses them once the run is unlinked. The notes of an exited thread go to the next new
+ * thread, they are never freed: next_ of an unlinked node may still name a reused note, which is harmless, as the link it would swing is gone.
+ */
+template<typename NODE, typename RECLAIM>
+class LockFreeUnlinkNotes {
+public:
+    static const size_t kRunLength = 64;
+
+    struct Note {
+        typename RECLAIM::template Link<NODE> next;  // the successor of the removed node
+        typename NODE::NodePtr marker;                // the tagged note, linked as next_ of the removed node
+        atomic<uint64_t> claims{0};                   // counts the claims with the note, bumped by the owner only
+        atomic<uint64_t> helped{0};                   // the claim whose node another thread unlinked
+    };
+
+    // The i-th note of the calling thread, i < kRunLength
+    static Note& Local(size_t i) {
+        return localRecord()->notes[i];
+    }
+
+    // The note linked as next_ of node, nullptr if node is not removed by a list
+    static Note* Of(NODE* node) {
+        const void* next = node->next_.Peek();
+        if (!isUnlinkNote(next))
+            return nullptr;
+        return reinterpret_cast<Note*>(reinterpret_cast<uintptr_t>(next) & ~uintptr_t(1));
+    }
+
+private:
+    struct Record {
+        Record* next = nullptr;
+        atomic<bool> active{true};
+        Note notes[kRunLength];
+
+        Record() {
+            for (Note& note : notes)
+                note.marker = NODE::Marker(&note);
+        }
+    };
+
+    struct LocalRecord {
+        Record* record = nullptr;
+
+        ~LocalRecord() {
+            if (record != nullptr)
+                record->active.store(false, memory_order_release);
+        }
+    };
+
+    static atomic<Record*> records_;
+
+    static Record* localRecord() {
+        static thread_local LocalRecord local;
+        if (local.record == nullptr)
+            local.record = acquireRecord();
+        return local.record;
+    }
+
+    static Record* acquireRecord() {
+        for (Record* record = records_.load(); record != nullptr; record = record->next) {
+            bool inactive = false;
+            if (!record->active.load(memory_order_relaxed) && record->active.compare_exchange_strong(inactive, true))
+                return record;
+        }
+        Record* record = new Record();
+        Record* head = records_.load();
+        do {
+            record->next = head;
+        } while (!records_.compare_exchange_weak(head, record));
+        return record;
+    }
+};
+
+template<typename NODE, typename RECLAIM>
+atomic<typename LockFreeUnlinkNotes<NODE, RECLAIM>::Record*> LockFreeUnlinkNotes<NODE, RECLAIM>::records_{nullptr};
+
+#endif //LOCKFREE_UNLINK_H
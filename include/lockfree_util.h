@@ -0,0 +1,37 @@
+#ifndef LOCKFREE_UTIL_H
+#define LOCKFREE_UTIL_H
+
+#include <cstddef>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+static const size_t kCacheLineSize = 64;
+
+/**
+ * Asks the CPU to fetch the cache line of address for reading, a hint only: address may be stale or nullptr.
+ */
+inline void Prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    if (address != nullptr)
+        __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+/**
+ * Tells the CPU the thread is spinning: saves power and leaves the core to the sibling hyper-thread.
+ */
+inline void CpuRelax() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+    __asm__ __volatile__("yield");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#endif
+}
+
+#endif //LOCKFREE_UTIL_H
@@ -2,17 +2,17 @@
 #define CombineAtomic_H__
 
 #include <atomic>
-#include <iostream>
+#include <cstdint>
 #include <memory>
-#include <tuple>
-
-#include <memory>
-#include <atomic>
 #include <utility>
-#include <functional>
 
 using namespace std;
 
+/**
+ * A shared_ptr link with a mark bit packed into the low bit of the stored pointer.
+ * The marked value is an aliasing shared_ptr of the same owner, so a marked link keeps its target alive
+ * and the mark and the pointer are always read and swapped together.
+ */
 template<typename T>
 class MarkedAtomic {
 public:
@@ -24,40 +24,46 @@ public:
         set(ptr, mark);
     }
 
-    virtual ~MarkedAtomic() {}
-
     // Compare and set the value atomically
-    inline bool compareAndSet(shared_ptr<T> oldPtr, shared_ptr<T> newPtr, bool oldMark, bool newMark) {
-        T* oldCombined = reinterpret_cast<T*>(uintptr_t(oldPtr.get()) | oldMark);
-        T* newCombined = reinterpret_cast<T*>(uintptr_t(newPtr.get()) | newMark);
-        return combined.compare_exchange_strong(oldCombined, newCombined);
+    inline bool compareAndSet(const shared_ptr<T>& oldPtr, const shared_ptr<T>& newPtr, bool oldMark, bool newMark) {
+        shared_ptr<T> oldCombined = combine(oldPtr, oldMark);
+        return atomic_compare_exchange_strong(&combined, &oldCombined, combine(newPtr, newMark));
     }
 
     // Get the current pointer and mark value
     inline pair<shared_ptr<T>, bool> get() const {
-        T* combinedVal = combined.load();
-        shared_ptr<T> ptr(reinterpret_cast<T*>(uintptr_t(combinedVal) & ~uintptr_t(1)), [](T *){});
-        bool mark = uintptr_t(combinedVal) & uintptr_t(1);
-        return {ptr, mark};
+        shared_ptr<T> combinedVal = atomic_load(&combined);
+        uintptr_t value = reinterpret_cast<uintptr_t>(combinedVal.get());
+        return {shared_ptr<T>(combinedVal, reinterpret_cast<T*>(value & ~uintptr_t(1))), (value & uintptr_t(1)) != 0};
     }
 
-    // Get the raw pointer
+    // Get the pointer without the mark
     inline shared_ptr<T> getPtr() const {
         return get().first;
     }
 
+    // Get the raw pointer without the mark, for identity checks only
+    inline T* peek() const {
+        return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(atomic_load(&combined).get()) & ~uintptr_t(1));
+    }
+
     // Check if the node is logically deleted
     inline bool isMarked() const {
-        return get().second;
+        return (reinterpret_cast<uintptr_t>(atomic_load(&combined).get()) & uintptr_t(1)) != 0;
     }
 
     // Set the pointer and mark value
-    inline void set(shared_ptr<T> ptr, bool mark) {
-        uintptr_t value = reinterpret_cast<uintptr_t>(ptr.get()) | mark;
-        combined.store(reinterpret_cast<T*>(value));
+    inline void set(const shared_ptr<T>& ptr, bool mark) {
+        atomic_store(&combined, combine(ptr, mark));
     }
 
 private:
-    atomic<T*> combined;  // Use uintptr_t to store both pointer and mark flag
+    shared_ptr<T> combined;  // an aliasing shared_ptr carries the mark in the low bit of its stored pointer
+
+    static shared_ptr<T> combine(const shared_ptr<T>& ptr, bool mark) {
+        if (!mark)
+            return ptr;
+        return shared_ptr<T>(ptr, reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(ptr.get()) | uintptr_t(1)));
+    }
 };
-#endif
\ No newline at end of file
+#endif
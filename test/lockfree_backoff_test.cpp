@@ -0,0 +1,50 @@
+#include "test_linkedlist.h"
+
+#include <thread>
+#include <vector>
+
+#include "lockfree_backoff.h"
+
+TEST_CASE("backoff, every policy returns from Wait", "[backoff]") {
+    NoBackoff none;
+    ExponentialBackoff<1, 64> exponential;
+    SpinYieldBackoff<4> spinYield;
+    for (int i = 0; i < 100; i++) {
+        none.Wait();
+        exponential.Wait();
+        spinYield.Wait();
+        AdaptiveBackoff<64> adaptive;
+        for (int j = 0; j < i % 10; j++)
+            adaptive.Wait();
+    }
+    uint32_t first = BackoffRandom();
+    REQUIRE(first != BackoffRandom());
+}
+
+TEMPLATE_TEST_CASE("backoff, lists retry with the policy", "[backoff]",
+                   NoBackoff, ExponentialBackoff<>, SpinYieldBackoff<>, AdaptiveBackoff<>) {
+    const int threadNum = 8;
+    const int loops = 1000;
+
+    LockFreeSiList<int, SharedPtrReclaim, LockFreeNode, ExactCounter, CompactLayout, TestType> list;
+    LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode, ExactCounter, CompactLayout, TestType> markedList;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++) {
+                list.Append(make_shared<LockFreeNode<int>>(t * loops + i));
+                markedList.InsertHead(make_shared<LockFreeMarkedBiNode<int>>(i));
+                markedList.Append(make_shared<LockFreeMarkedBiNode<int>>(i));
+                if (i % 2 == 1) {
+                    markedList.PopHead();
+                    markedList.PopTail();
+                }
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(list.CheckConsistence(threadNum * loops));
+    REQUIRE(markedList.CheckConsistence(threadNum * loops));
+}
@@ -0,0 +1,89 @@
+#include "test_linkedlist.h"
+
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+// Links count new nodes valued from..from+count-1 with SetNext only, as a caller builds a batch
+template<typename NODE>
+std::pair<shared_ptr<NODE>, shared_ptr<NODE>> makeChain(int from, int count) {
+    shared_ptr<NODE> first = make_shared<NODE>(from);
+    shared_ptr<NODE> last = first;
+    for (int i = 1; i < count; i++) {
+        shared_ptr<NODE> node = make_shared<NODE>(from + i);
+        last->SetNext(node);
+        last = node;
+    }
+    return make_pair(first, last);
+}
+
+}
+
+TEMPLATE_TEST_CASE("chain, append and insert head a chain in order", "[chain]",
+                   (std::tuple<LockFreeSiList<int>, LockFreeNode<int>>),
+                   (std::tuple<LockFreeBiList<int>, LockFreeBiNode<int>>),
+                   (std::tuple<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+
+    ListType list;
+    auto middle = makeChain<NodeType>(10, 5);
+    REQUIRE(list.AppendChain(middle.first, middle.second, 5));
+    auto tail = makeChain<NodeType>(15, 3);
+    REQUIRE(list.AppendChain(tail.first, tail.second, 3));
+    auto head = makeChain<NodeType>(7, 3);
+    REQUIRE(list.InsertHeadChain(head.first, head.second, 3));
+    auto single = makeChain<NodeType>(6, 1);
+    REQUIRE(list.InsertHeadChain(single.first, single.second, 1));
+
+    REQUIRE(list.Head() == single.first);
+    REQUIRE(list.Tail() == tail.second);
+    REQUIRE(list.GetPrev(middle.first) == head.second);
+    REQUIRE(list.GetPrev(tail.first) == middle.second);
+    int expected = 6;
+    for (auto node = list.Head(); node != nullptr; node = list.GetNext(node))
+        REQUIRE(node->data_ == expected++);
+    REQUIRE(expected == 18);
+    REQUIRE(list.CheckConsistence(12));
+
+    REQUIRE(list.PopTail() == tail.second);
+    REQUIRE(list.PopHead() == single.first);
+    REQUIRE(list.CheckConsistence(10));
+}
+
+TEMPLATE_TEST_CASE("chain, multi-threads append chains", "[chain]",
+                   (std::tuple<LockFreeSiList<int>, LockFreeNode<int>>),
+                   (std::tuple<LockFreeBiList<int>, LockFreeBiNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+    const int threadNum = 4;
+    const int batches = 200;
+    const int batchSize = 16;
+
+    ListType list;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < batches; i++) {
+                auto chain = makeChain<NodeType>((t * batches + i) * batchSize, batchSize);
+                list.AppendChain(chain.first, chain.second, batchSize);
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(list.CheckConsistence(threadNum * batches * batchSize));
+    // every batch stays contiguous and in order
+    int linked = 0;
+    for (auto node = list.Head(); node != nullptr; node = list.GetNext(node)) {
+        if (node->data_ % batchSize != 0)
+            REQUIRE(list.GetPrev(node)->data_ == node->data_ - 1);
+        linked++;
+    }
+    REQUIRE(linked == threadNum * batches * batchSize);
+}
@@ -0,0 +1,74 @@
+#include "test_linkedlist.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "lockfree_combining.h"
+
+// The combiner applies the requests one at a time, so the default list takes removers at the head from every thread
+TEST_CASE("combining, multi-threads append and pop head through the combiner", "[combining]") {
+    using ListType = LockFreeCombiningList<LockFreeSiList<int>>;
+    const int threadNum = 4;
+    const int loops = 3000;
+
+    ListType list(CombiningMode::kCombining);
+    std::vector<std::vector<int>> removed(threadNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++) {
+                auto node = make_shared<LockFreeNode<int>>(t * loops + i);
+                i % 2 == 0 ? list.Append(node) : list.InsertHead(node);
+                if (i % 3 == 0) {
+                    if (list.Remove(node)) // or popped by another thread already
+                        removed[t].push_back(node->data_);
+                } else if (i % 3 == 1) {
+                    auto head = list.PopHead();
+                    if (head != nullptr)
+                        removed[t].push_back(head->data_);
+                }
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(list.IsCombining());
+    std::vector<int> seen(threadNum * loops, 0);
+    for (auto& values : removed)
+        for (int value : values)
+            seen[value]++;
+    int64_t left = 0;
+    for (auto node = list.Head(); node != nullptr; node = list.GetNext(node), left++)
+        seen[node->data_]++;
+    REQUIRE(list.CheckConsistence(left));
+    REQUIRE(std::count(seen.begin(), seen.end(), 1) == threadNum * loops);
+}
+
+TEST_CASE("combining, adaptive mode leaves combining when the batches stay small", "[combining]") {
+    using ListType = LockFreeCombiningList<LockFreeBiList<int, SharedPtrReclaim, LockFreeBiNode, ExactCounter,
+                                                          CompactLayout, CountingBackoff<>>>;
+    ListType list(CombiningMode::kCombining);
+    list.Append(make_shared<LockFreeBiNode<int>>(0));
+    list.SetMode(CombiningMode::kAdaptive);
+    REQUIRE(list.IsCombining());
+    for (int i = 1; i < 100; i++)
+        list.Append(make_shared<LockFreeBiNode<int>>(i));
+    REQUIRE_FALSE(list.IsCombining());
+    REQUIRE(list.PopHead()->data_ == 0);
+    REQUIRE(list.CheckConsistence(99));
+
+    list.SetMode(CombiningMode::kLockFree);
+    REQUIRE_FALSE(list.IsCombining());
+    REQUIRE(list.Remove(list.Tail()));
+    REQUIRE(list.CheckConsistence(98));
+}
+
+TEST_CASE("combining, counting backoff counts the failed CAS", "[combining]") {
+    uint64_t failures = BackoffFailures();
+    CountingBackoff<ExponentialBackoff<>> backoff;
+    backoff.Wait();
+    backoff.Wait();
+    REQUIRE(BackoffFailures() == failures + 2);
+}
@@ -0,0 +1,40 @@
+#include "test_linkedlist.h"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("counter policies, size of the list", "[counter]") {
+    LockFreeSiList<int, SharedPtrReclaim, LockFreeNode, ExactCounter> exactList;
+    LockFreeSiList<int, SharedPtrReclaim, LockFreeNode, ShardedCounter> shardedList;
+    LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode, NoCounter> uncountedList;
+    for (int i = 0; i < 3; i++) {
+        exactList.Append(make_shared<LockFreeNode<int>>(i));
+        shardedList.Append(make_shared<LockFreeNode<int>>(i));
+        uncountedList.Append(make_shared<LockFreeMarkedBiNode<int>>(i));
+    }
+    exactList.PopHead();
+    shardedList.PopHead();
+    uncountedList.PopHead();
+
+    REQUIRE(exactList.Size() == 2);
+    REQUIRE(shardedList.Size() == 2);
+    REQUIRE(uncountedList.Size() == -1);
+    REQUIRE(uncountedList.CheckConsistence(2));
+}
+
+TEST_CASE("counter policies, sharded counter sums every thread", "[counter]") {
+    const int threadNum = 40;
+    const int addNum = 1000;
+
+    ShardedCounter counter;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < addNum; i++)
+                counter.Add(t % 2 == 0 ? 2 : -1);
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+    REQUIRE(counter.Get() == threadNum / 2 * addNum);
+}
@@ -0,0 +1,125 @@
+#include "test_linkedlist.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "lockfree_deque.h"
+
+TEST_CASE("deque, push and pop at both ends", "[deque]") {
+    using NodeType = LockFreeDeque<int>::NodeType;
+    LockFreeDeque<int> deque;
+    REQUIRE(deque.Empty());
+    REQUIRE(deque.PopFront() == nullptr);
+    REQUIRE(deque.PopBack() == nullptr);
+
+    for (int i = 0; i < 5; i++) {
+        deque.PushBack(make_shared<NodeType>(i));
+        deque.PushFront(make_shared<NodeType>(-i - 1));
+    }
+    REQUIRE(deque.CheckConsistence(10));
+    REQUIRE(deque.PopFront()->data_ == -5);
+    REQUIRE(deque.PopBack()->data_ == 4);
+    REQUIRE(deque.Head()->data_ == -4);
+    REQUIRE(deque.Tail()->data_ == 3);
+    REQUIRE(deque.CheckConsistence(8));
+
+    for (int i = 0; i < 4; i++)
+        REQUIRE(deque.PopBack()->data_ == 3 - i);
+    for (int i = 0; i < 4; i++)
+        REQUIRE(deque.PopBack()->data_ == -i - 1);
+    REQUIRE(deque.Empty());
+    REQUIRE(deque.Tail() == nullptr);
+    REQUIRE(deque.CheckConsistence(0));
+
+    deque.PushFront(make_shared<NodeType>(1));
+    REQUIRE(deque.PopBack()->data_ == 1);
+    deque.PushBack(make_shared<NodeType>(2));
+    REQUIRE(deque.PopFront()->data_ == 2);
+    REQUIRE(deque.CheckConsistence(0));
+}
+
+// Producers push at the back, consumers pop at the front: every item is popped once and every consumer sees the items
+// of a producer in order
+TEST_CASE("deque, multi-threads push back and pop front", "[deque]") {
+    using NodePtr = LockFreeDeque<int>::NodePtr;
+    const int producerNum = 2;
+    const int consumerNum = 2;
+    const int loops = 5000;
+
+    LockFreeDeque<int> deque;
+    std::atomic<int> producing(producerNum);
+    std::vector<std::vector<int>> consumed(consumerNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producerNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++)
+                deque.PushBack(make_shared<LockFreeDeque<int>::NodeType>(t * loops + i));
+            producing--;
+        }));
+    }
+    for (int c = 0; c < consumerNum; c++) {
+        threads.push_back(std::thread([&, c]() {
+            while (true) {
+                bool done = producing == 0;
+                NodePtr node = deque.PopFront();
+                if (node != nullptr)
+                    consumed[c].push_back(node->data_);
+                else if (done)
+                    break;
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(deque.CheckConsistence(0));
+    std::vector<int> seen(producerNum * loops, 0);
+    for (auto& values : consumed) {
+        std::vector<int> lastOfProducer(producerNum, -1);
+        for (int value : values) {
+            seen[value]++;
+            int producer = value / loops;
+            REQUIRE(value > lastOfProducer[producer]);
+            lastOfProducer[producer] = value;
+        }
+    }
+    REQUIRE(std::count(seen.begin(), seen.end(), 1) == producerNum * loops);
+}
+
+// Every thread pushes and pops at both ends, a popped item was pushed and no item is popped twice
+TEST_CASE("deque, multi-threads at both ends", "[deque]") {
+    using NodePtr = LockFreeDeque<int>::NodePtr;
+    const int threadNum = 4;
+    const int loops = 4000;
+
+    LockFreeDeque<int> deque;
+    std::vector<std::vector<int>> popped(threadNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++) {
+                auto node = make_shared<LockFreeDeque<int>::NodeType>(t * loops + i);
+                (i + t) % 2 == 0 ? deque.PushFront(node) : deque.PushBack(node);
+                if (i % 3 != 0) {
+                    NodePtr removed = (i + t) % 4 < 2 ? deque.PopBack() : deque.PopFront();
+                    if (removed != nullptr)
+                        popped[t].push_back(removed->data_);
+                }
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    std::vector<int> seen(threadNum * loops, 0);
+    for (auto& values : popped)
+        for (int value : values)
+            seen[value]++;
+    NodePtr node;
+    while ((node = deque.PopFront()) != nullptr)
+        seen[node->data_]++;
+    REQUIRE(std::count(seen.begin(), seen.end(), 1) == threadNum * loops);
+    REQUIRE(deque.CheckConsistence(0));
+}
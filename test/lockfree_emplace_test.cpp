@@ -0,0 +1,138 @@
+#include "test_linkedlist.h"
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "epoch_reclaim.h"
+#include "lockfree_deque.h"
+#include "lockfree_skip_list.h"
+#include "lockfree_sorted_list.h"
+#include "lockfree_stack.h"
+
+struct Quote {
+    std::string symbol;
+    int price;
+
+    Quote(std::string symbol, int price) : symbol(std::move(symbol)), price(price) {}
+    Quote(const Quote&) = delete;
+    Quote& operator=(const Quote&) = delete;
+};
+
+// true if the Emplace inserts of LIST can be called from outside with ARGS (a tuple of the constructor arguments)
+template<typename LIST, typename ARGS, typename = void>
+struct CanEmplace : false_type {};
+
+template<typename LIST, typename... ARGS>
+struct CanEmplace<LIST, tuple<ARGS...>, decltype(void(declval<LIST&>().Emplace(declval<ARGS>()...)))> : true_type {};
+
+template<typename LIST, typename ARGS, typename = void>
+struct CanEmplaceHead : false_type {};
+
+template<typename LIST, typename... ARGS>
+struct CanEmplaceHead<LIST, tuple<ARGS...>, decltype(void(declval<LIST&>().EmplaceHead(declval<ARGS>()...)))>
+    : true_type {};
+
+template<typename LIST, typename ARGS, typename = void>
+struct CanEmplaceBefore : false_type {};
+
+template<typename LIST, typename... ARGS>
+struct CanEmplaceBefore<LIST, tuple<ARGS...>, decltype(void(declval<LIST&>().EmplaceBefore(
+    declval<const typename LIST::NodePtr&>(), declval<ARGS>()...)))> : true_type {};
+
+template<typename LIST, typename ARGS>
+bool emplaceReachable() {
+    return CanEmplace<LIST, ARGS>::value || CanEmplaceHead<LIST, ARGS>::value || CanEmplaceBefore<LIST, ARGS>::value;
+}
+
+TEMPLATE_TEST_CASE("emplace, move-only data", "[emplace]",
+                   (LockFreeSiList<unique_ptr<int>>),
+                   (LockFreeBiList<unique_ptr<int>>),
+                   (LockFreeSiList<unique_ptr<int>, SharedPtrReclaim, LockFreeMarkedNode>),
+                   (LockFreeBiList<unique_ptr<int>, SharedPtrReclaim, LockFreeMarkedBiNode>)) {
+    TestType list;
+    auto second = list.Emplace(new int(2));
+    list.Emplace(unique_ptr<int>(new int(4)));
+    auto first = list.EmplaceHead(new int(1));
+    REQUIRE(*list.EmplaceBefore(list.Tail(), new int(3))->data_ == 3);
+    REQUIRE(*list.GetNext(second)->data_ == 3);
+    REQUIRE(list.CheckConsistence(4));
+
+    unique_ptr<int> value;
+    REQUIRE(list.PopHead(value));
+    REQUIRE(*value == 1);
+    // the removed node is left with the moved-from data
+    REQUIRE(first->data_ == nullptr);
+    REQUIRE(list.PopTail(value));
+    REQUIRE(*value == 4);
+    REQUIRE(list.PopHead() == second);
+    REQUIRE(*second->data_ == 2);
+    REQUIRE(list.PopHead(value));
+    REQUIRE(*value == 3);
+    REQUIRE_FALSE(list.PopHead(value));
+    REQUIRE(*value == 3);
+    REQUIRE(list.CheckConsistence(0));
+}
+
+TEST_CASE("emplace, data constructed in place", "[emplace]") {
+    LockFreeBiList<Quote> list;
+    list.Emplace("AAPL", 100);
+    list.EmplaceHead(std::string("MSFT"), 200);
+    auto head = list.Head();
+    REQUIRE(head->data_.symbol == "MSFT");
+    REQUIRE(list.GetNext(head)->data_.price == 100);
+    REQUIRE(list.CheckConsistence(2));
+}
+
+// Producers emplace move-only data, one consumer moves it out
+TEST_CASE("emplace, multi-threads emplace and pop into values", "[emplace]") {
+    using ListType = LockFreeSiList<unique_ptr<int>, EpochReclaim>;
+    const int threadNum = 4;
+    const int loops = 2000;
+
+    ListType list;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++)
+                list.Emplace(new int(t * loops + i));
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+    REQUIRE(list.CheckConsistence(threadNum * loops));
+
+    std::vector<int> seen(threadNum * loops, 0);
+    unique_ptr<int> value;
+    int popped = 0;
+    while (list.PopHead(value)) {
+        seen[*value]++;
+        popped++;
+    }
+    REQUIRE(popped == threadNum * loops);
+    REQUIRE(std::count(seen.begin(), seen.end(), 1) == threadNum * loops);
+    REQUIRE(list.CheckConsistence(0));
+}
+
+TEST_CASE("emplace, hidden on the sorted list", "[emplace]") {
+    REQUIRE(emplaceReachable<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, tuple<int>>());
+    // an unordered insert would break the order of the set
+    REQUIRE_FALSE(emplaceReachable<LockFreeSortedList<int>, tuple<int>>());
+}
+
+TEST_CASE("emplace, hidden on the skip list", "[emplace]") {
+    REQUIRE(emplaceReachable<LockFreeMarkedList<LockFreeSkipNode<int, int>>, tuple<int, int>>());
+    REQUIRE_FALSE(emplaceReachable<LockFreeSkipList<int, int>, tuple<int, int>>());
+}
+
+TEST_CASE("emplace, hidden on the deque", "[emplace]") {
+    REQUIRE(emplaceReachable<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, tuple<int>>());
+    REQUIRE_FALSE(emplaceReachable<LockFreeDeque<int>, tuple<int>>());
+}
+
+TEST_CASE("emplace, hidden on the stack", "[emplace]") {
+    REQUIRE_FALSE(emplaceReachable<LockFreeStack<int>, tuple<int>>());
+}
@@ -0,0 +1,99 @@
+#include "test_linkedlist.h"
+
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lockfree_hash_map.h"
+
+// every key of a bucket collides, the keys are told apart by EQUAL
+struct CollidingHash {
+    size_t operator()(int key) const {
+        return key % 4;
+    }
+};
+
+TEST_CASE("hash map, insert, find and erase", "[hashmap]") {
+    LockFreeHashMap<std::string, int> map;
+    REQUIRE(map.Insert("one", 1));
+    REQUIRE(map.Insert("two", 2));
+    REQUIRE_FALSE(map.Insert("one", 10));
+    REQUIRE(map.Size() == 2);
+
+    REQUIRE(map.Find("one")->data_.value == 1);
+    REQUIRE(map.Contains("two"));
+    REQUIRE(map.Find("three") == nullptr);
+
+    REQUIRE(map.Erase("one")->data_.value == 1);
+    REQUIRE(map.Erase("one") == nullptr);
+    REQUIRE_FALSE(map.Contains("one"));
+    REQUIRE(map.CheckConsistence(1));
+}
+
+TEST_CASE("hash map, growing buckets and colliding hashes", "[hashmap]") {
+    LockFreeHashMap<int, int> map;
+    for (int key = 0; key < 5000; key++)
+        REQUIRE(map.Insert(key, key * 3));
+    REQUIRE(map.BucketCount() >= 2048);
+    for (int key = 0; key < 5000; key += 2)
+        REQUIRE(map.Erase(key) != nullptr);
+    for (int key = 0; key < 5000; key++)
+        REQUIRE(map.Contains(key) == (key % 2 == 1));
+    REQUIRE(map.CheckConsistence(2500));
+
+    LockFreeHashMap<int, int, CollidingHash> colliding;
+    for (int key = 0; key < 100; key++)
+        REQUIRE(colliding.Insert(key, key));
+    REQUIRE(colliding.Erase(42) != nullptr);
+    REQUIRE(colliding.Find(43)->data_.value == 43);
+    REQUIRE_FALSE(colliding.Contains(42));
+    REQUIRE(colliding.CheckConsistence(99));
+
+    // the sharded counter grows the buckets as well
+    LockFreeHashMap<int, int, hash<int>, equal_to<int>, ShardedCounter> sharded;
+    for (int key = 0; key < 5000; key++)
+        REQUIRE(sharded.Insert(key, key));
+    REQUIRE(sharded.BucketCount() >= 2048);
+    REQUIRE(sharded.CheckConsistence(5000));
+}
+
+TEST_CASE("hash map, multi-threads insert, find and erase", "[hashmap]") {
+    const int threadNum = 8;
+    const int keyNum = 4000;
+    const int loops = 8000;
+
+    LockFreeHashMap<int, int> map;
+    atomic<int> inserted(0);
+    atomic<int> erased(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            std::minstd_rand linearRand(t + 1);
+            std::uniform_int_distribution<int> distrib(0, keyNum - 1);
+            for (int i = 0; i < loops; i++) {
+                int key = distrib(linearRand);
+                if (i % 3 != 2) {
+                    if (map.Insert(key, t))
+                        inserted.fetch_add(1);
+                } else if (map.Erase(key) != nullptr) {
+                    erased.fetch_add(1);
+                }
+                map.Find(key);
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(map.CheckConsistence(inserted.load() - erased.load()));
+}
+
+// the destructor must not release the chain of the list recursively
+TEST_CASE("hash map, large map destroyed", "[hashmap]") {
+    const int keyNum = 1000000;
+    LockFreeHashMap<int, int> map;
+    for (int key = 0; key < keyNum; key++)
+        map.Insert(key, key);
+    REQUIRE(map.Size() == keyNum);
+}
@@ -0,0 +1,118 @@
+#include "test_linkedlist.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "epoch_reclaim.h"
+
+struct Order : LockFreeHook<Order> {
+    int id;
+    std::string symbol;
+
+    Order(int id, std::string symbol) : id(id), symbol(std::move(symbol)) {}
+};
+
+struct BiOrder : LockFreeBiHook<BiOrder> {
+    int id;
+
+    explicit BiOrder(int id) : id(id) {}
+};
+
+struct EpochOrder : LockFreeHook<EpochOrder, EpochReclaim> {
+    static atomic<int> alive;
+    int id;
+
+    explicit EpochOrder(int id) : id(id) { alive.fetch_add(1); }
+    ~EpochOrder() { alive.fetch_sub(1); }
+};
+
+atomic<int> EpochOrder::alive(0);
+
+TEST_CASE("hook, objects linked directly", "[hook]") {
+    LockFreeSiList<Order, SharedPtrReclaim, LockFreeIntrusiveNode> list;
+    std::vector<shared_ptr<Order>> orders;
+    for (int i = 0; i < 5; i++) {
+        orders.push_back(make_shared<Order>(i, "S" + std::to_string(i)));
+        REQUIRE(list.Append(orders.back()));
+    }
+    // the list holds the objects themselves
+    REQUIRE(list.Head() == orders[0]);
+    REQUIRE(list.Tail() == orders[4]);
+
+    REQUIRE(list.Remove(orders[2]));
+    REQUIRE(orders[2]->isDeleted());
+    REQUIRE(list.PopHead() == orders[0]);
+    REQUIRE(list.InsertHead(make_shared<Order>(9, "S9")));
+
+    std::vector<int> ids;
+    for (Order& order : list)
+        ids.push_back(order.id);
+    REQUIRE(ids == std::vector<int>({9, 1, 3, 4}));
+    REQUIRE(list.CheckConsistence(4));
+
+    // a copy starts unlinked
+    Order copy(*orders[3]);
+    REQUIRE(copy.Next() == nullptr);
+    REQUIRE(copy.symbol == "S3");
+}
+
+TEST_CASE("hook, bidirectional objects", "[hook]") {
+    LockFreeBiList<BiOrder, SharedPtrReclaim, LockFreeIntrusiveNode> list;
+    std::vector<shared_ptr<BiOrder>> orders;
+    for (int i = 0; i < 5; i++) {
+        orders.push_back(make_shared<BiOrder>(i));
+        list.Append(orders.back());
+    }
+    REQUIRE(list.Remove(orders[1]));
+    REQUIRE(list.PopTail() == orders[4]);
+
+    std::vector<int> ids;
+    for (auto it = list.rbegin(); it != list.rend(); ++it)
+        ids.push_back(it->id);
+    REQUIRE(ids == std::vector<int>({3, 2, 0}));
+    REQUIRE(orders[3]->Prev() == orders[2]);
+    REQUIRE(list.CheckConsistence(3));
+}
+
+TEST_CASE("hook, objects owned by the list", "[hook]") {
+    int before = EpochOrder::alive.load();
+    {
+        LockFreeSiList<EpochOrder, EpochReclaim, LockFreeIntrusiveNode> list;
+        for (int i = 0; i < 10; i++)
+            list.Append(new EpochOrder(i));
+        {
+            EpochReclaim::Guard guard;
+            REQUIRE(list.PopHead()->id == 0);
+        }
+        EpochDomain::Instance().Flush();
+        REQUIRE(EpochOrder::alive.load() == before + 9);
+    }
+    REQUIRE(EpochOrder::alive.load() == before);
+}
+
+// Appenders share one list of hooked objects, emptied afterwards
+TEST_CASE("hook, multi-threads append", "[hook]") {
+    const int threadNum = 4;
+    const int loops = 2000;
+
+    LockFreeBiList<BiOrder, SharedPtrReclaim, LockFreeIntrusiveNode> list;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++) {
+                list.Append(make_shared<BiOrder>(t * loops + i));
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(list.CheckConsistence(threadNum * loops));
+    int popped = 0;
+    while (list.PopHead() != nullptr)
+        popped++;
+    REQUIRE(popped == threadNum * loops);
+    REQUIRE(list.CheckConsistence(0));
+}
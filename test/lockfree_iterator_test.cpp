@@ -0,0 +1,109 @@
+#include "test_linkedlist.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "epoch_reclaim.h"
+
+TEMPLATE_TEST_CASE("iterator, range-for and algorithms", "[iterator]",
+                   (std::tuple<LockFreeSiList<int>, LockFreeNode<int>>),
+                   (std::tuple<LockFreeBiList<int>, LockFreeBiNode<int>>),
+                   (std::tuple<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+
+    ListType list;
+    REQUIRE(list.begin() == list.end());
+    std::vector<shared_ptr<NodeType>> nodes;
+    for (int i = 0; i < 5; i++) {
+        nodes.push_back(make_shared<NodeType>(i));
+        list.Append(nodes.back());
+    }
+    list.Remove(nodes[2]);
+
+    std::vector<int> values;
+    for (NodeType& node : list)
+        values.push_back(node.data_);
+    REQUIRE(values == std::vector<int>({0, 1, 3, 4}));
+
+    auto it = std::find_if(list.begin(), list.end(), [](const NodeType& node) { return node.data_ == 3; });
+    REQUIRE(it.Node() == nodes[3]);
+    REQUIRE(it->data_ == 3);
+    REQUIRE(std::distance(list.begin(), list.end()) == 4);
+}
+
+TEMPLATE_TEST_CASE("iterator, reverse iteration of a bidirectional list", "[iterator]",
+                   (std::tuple<LockFreeBiList<int>, LockFreeBiNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+
+    ListType list;
+    std::vector<shared_ptr<NodeType>> nodes;
+    for (int i = 0; i < 5; i++) {
+        nodes.push_back(make_shared<NodeType>(i));
+        list.Append(nodes.back());
+    }
+    list.Remove(nodes[1]);
+
+    std::vector<int> values;
+    for (auto it = list.rbegin(); it != list.rend(); ++it)
+        values.push_back(it->data_);
+    REQUIRE(values == std::vector<int>({4, 3, 2, 0}));
+}
+
+TEST_CASE("iterator, current node removed during the scan", "[iterator]") {
+    LockFreeSiList<int> list;
+    std::vector<shared_ptr<LockFreeNode<int>>> nodes;
+    for (int i = 0; i < 4; i++) {
+        nodes.push_back(make_shared<LockFreeNode<int>>(i));
+        list.Append(nodes.back());
+    }
+
+    std::vector<int> values;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        values.push_back(it->data_);
+        if (it->data_ == 1)
+            list.Remove(it.Node());
+    }
+    REQUIRE(values == std::vector<int>({0, 1, 2, 3}));
+    REQUIRE(list.CheckConsistence(3));
+}
+
+TEST_CASE("iterator, multi-threads scan while the list changes", "[iterator]") {
+    using ListType = LockFreeBiList<int, EpochReclaim>;
+    using NodeType = LockFreeBiNode<int, EpochReclaim>;
+    const int nodeNum = 1000;
+    const int loops = 200;
+
+    ListType list;
+    for (int i = 0; i < nodeNum; i++)
+        list.Append(new NodeType(i));
+
+    atomic<bool> wrongOrder(false);
+    std::thread reader([&]() {
+        for (int i = 0; i < loops; i++) {
+            EpochGuard guard;
+            int last = -1;
+            for (NodeType& node : list) {
+                if (node.data_ >= 0 && node.data_ <= last)
+                    wrongOrder.store(true);
+                if (node.data_ >= 0)
+                    last = node.data_;
+            }
+        }
+    });
+    std::thread writer([&]() {
+        for (int i = 0; i < loops; i++) {
+            NodeType* node = new NodeType(-1);
+            list.InsertHead(node);
+            list.Remove(node);
+        }
+    });
+    reader.join();
+    writer.join();
+    REQUIRE_FALSE(wrongOrder.load());
+    REQUIRE(list.CheckConsistence(nodeNum));
+}
@@ -0,0 +1,90 @@
+#include "test_linkedlist.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "epoch_reclaim.h"
+#include "lockfree_layout.h"
+
+namespace {
+
+template<typename X>
+bool sharesCacheLine(const X& first, const X& second) {
+    uintptr_t firstEnd = reinterpret_cast<uintptr_t>(&first) + sizeof(X) - 1;
+    uintptr_t secondBegin = reinterpret_cast<uintptr_t>(&second);
+    return firstEnd / kCacheLineSize == secondBegin / kCacheLineSize;
+}
+
+}
+
+TEST_CASE("layout, padded control words never share a cache line", "[layout]") {
+    using Slot = PaddedLayout::Slot<SharedPtrReclaim::Link<LockFreeNode<int>>>;
+    Slot slots[2];
+    REQUIRE_FALSE(sharesCacheLine<SharedPtrReclaim::Link<LockFreeNode<int>>>(slots[0], slots[1]));
+    REQUIRE(sizeof(Slot) >= 2 * kCacheLineSize + sizeof(SharedPtrReclaim::Link<LockFreeNode<int>>));
+    REQUIRE(sizeof(CompactLayout::Slot<ExactCounter>) == sizeof(ExactCounter));
+    REQUIRE(sizeof(LockFreeSiList<int, SharedPtrReclaim, LockFreeNode, ExactCounter, PaddedLayout>) >
+            sizeof(LockFreeSiList<int>) + 4 * kCacheLineSize);
+}
+
+TEST_CASE("layout, padded lists with head-side and tail-side threads", "[layout]") {
+    const int threadNum = 4;
+    const int loops = 2000;
+
+    LockFreeBiList<int, SharedPtrReclaim, LockFreeBiNode, ExactCounter, PaddedLayout> list;
+    LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode, ExactCounter, PaddedLayout> markedList;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++) {
+                if (t % 2 == 0) {
+                    list.InsertHead(make_shared<LockFreeBiNode<int>>(i));
+                    markedList.InsertHead(make_shared<LockFreeMarkedNode<int>>(i));
+                    if (i % 2 == 1) {
+                        list.PopHead();
+                        markedList.PopHead();
+                    }
+                } else {
+                    list.Append(make_shared<LockFreeBiNode<int>>(i));
+                    markedList.Append(make_shared<LockFreeMarkedNode<int>>(i));
+                    if (i % 2 == 1) {
+                        list.PopTail();
+                        markedList.PopTail();
+                    }
+                }
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(list.CheckConsistence(threadNum * loops / 2));
+    REQUIRE(markedList.CheckConsistence(threadNum * loops / 2));
+}
+
+TEST_CASE("layout, cache aligned nodes of every reclamation policy", "[layout]") {
+    using SharedReclaim = CacheAlignedReclaim<SharedPtrReclaim>;
+    using SharedNode = LockFreeBiNode<int, SharedReclaim>;
+    LockFreeBiList<int, SharedReclaim> sharedList;
+    for (int i = 0; i < 100; i++) {
+        auto node = SharedReclaim::Make<SharedNode>(i);
+        sharedList.Append(node);
+    }
+    REQUIRE(sharedList.PopHead()->data_ == 0);
+    REQUIRE(sharedList.CheckConsistence(99));
+
+    using Reclaim = CacheAlignedReclaim<EpochReclaim>;
+    using Node = LockFreeNode<int, Reclaim>;
+    LockFreeSiList<int, Reclaim> list;
+    for (int i = 0; i < 100; i++) {
+        auto node = Reclaim::Make<Node>(i);
+        REQUIRE(reinterpret_cast<uintptr_t>(node.get()) % kCacheLineSize == 0);
+        list.Append(node);
+    }
+    {
+        EpochReclaim::Guard guard;
+        REQUIRE(list.PopTail()->data_ == 99);
+    }
+    REQUIRE(list.CheckConsistence(99));
+}
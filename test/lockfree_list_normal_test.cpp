@@ -1,6 +1,8 @@
 #include "test_linkedlist.h"
 
 #include <cstdint>
+#include <type_traits>
+#include <vector>
 
 TEST_CASE_HEAD("normal test without concurrent, Push node from head and tail") {
     INIT_TYPE;
@@ -97,3 +99,55 @@ TEST_CASE_HEAD("normal test without concurrent, Remove middle node") {
     REQUIRE(list.GetPrev(node1Ptr) == node3Ptr);
     REQUIRE(list.GetNext(node1Ptr) == nullptr);
 }
+
+TEMPLATE_TEST_CASE("normal test without concurrent, Remove and insert with a predecessor hint", "[lockfree][hint]",
+                   (std::tuple<LockFreeSiList<int>, LockFreeNode<int>>),
+                   (std::tuple<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+
+    ListType list;
+    std::vector<shared_ptr<NodeType>> nodes;
+    for (int i = 0; i < 6; i++) {
+        nodes.push_back(shared_ptr<NodeType>(new NodeType(i)));
+        list.Append(nodes.back());
+    }
+
+    // evict every odd node while walking, the node visited before is the hint
+    shared_ptr<NodeType> prevNode;
+    for (shared_ptr<NodeType> node = list.Head(); node != nullptr; ) {
+        shared_ptr<NodeType> nextNode = list.GetNext(node);
+        if (node->data_ % 2 == 1)
+            REQUIRE(list.Remove(node, prevNode));
+        else
+            prevNode = node;
+        node = nextNode;
+    }
+    REQUIRE(list.CheckConsistence(3));
+    REQUIRE(list.GetNext(nodes[0]) == nodes[2]);
+    REQUIRE(list.GetNext(nodes[4]) == nullptr);
+    REQUIRE(list.Tail() == nodes[4]);
+
+    // a stale hint falls back to the search
+    REQUIRE(list.Remove(nodes[2], nodes[3]));
+    REQUIRE(list.GetNext(nodes[0]) == nodes[4]);
+
+    REQUIRE(list.Insert(nodes[1], nodes[4], nodes[0]));
+    REQUIRE(list.Insert(nodes[3], nodes[4], nodes[0]));
+    REQUIRE(list.GetNext(nodes[1]) == nodes[3]);
+    REQUIRE(list.GetPrev(nodes[4]) == nodes[3]);
+    REQUIRE(list.Remove(nodes[0], nullptr));
+    REQUIRE(list.Head() == nodes[1]);
+    REQUIRE(list.CheckConsistence(3));
+}
+
+TEST_CASE("normal test without concurrent, Nodes carry no vtable", "[lockfree][layout]") {
+    REQUIRE_FALSE(std::is_polymorphic<LockFreeNode<int>>::value);
+    REQUIRE_FALSE(std::is_polymorphic<LockFreeBiNode<int>>::value);
+    REQUIRE_FALSE(std::is_polymorphic<LockFreeMarkedNode<int>>::value);
+    REQUIRE_FALSE(std::is_polymorphic<LockFreeMarkedBiNode<int>>::value);
+    REQUIRE_FALSE(std::is_polymorphic<MarkedAtomic<int>>::value);
+    REQUIRE(sizeof(MarkedAtomic<int>) == sizeof(shared_ptr<int>));
+    REQUIRE(sizeof(LockFreeNode<int64_t>) == sizeof(shared_ptr<LockFreeNode<int64_t>>) + sizeof(int64_t));
+    REQUIRE(sizeof(LockFreeBiNode<int64_t>) == 2 * sizeof(shared_ptr<LockFreeNode<int64_t>>) + sizeof(int64_t));
+}
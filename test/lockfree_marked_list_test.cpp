@@ -0,0 +1,138 @@
+#include "test_linkedlist.h"
+
+#include <random>
+#include <thread>
+#include <vector>
+
+TEMPLATE_TEST_CASE("marked node list, push, insert and traverse", "[marked]",
+                   (std::tuple<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+
+    ListType list;
+    shared_ptr<NodeType> node1(new NodeType(1));
+    shared_ptr<NodeType> node2(new NodeType(2));
+    shared_ptr<NodeType> node3(new NodeType(3));
+    shared_ptr<NodeType> node4(new NodeType(4));
+    list.InsertHead(node1);
+    list.Append(node2);
+    list.InsertHead(node3);
+    list.Insert(node4, node2);
+
+    REQUIRE(list.Head() == node3);
+    REQUIRE(list.Tail() == node2);
+    REQUIRE(list.GetNext(node3) == node1);
+    REQUIRE(list.GetNext(node1) == node4);
+    REQUIRE(list.GetNext(node4) == node2);
+    REQUIRE(list.GetNext(node2) == nullptr);
+    REQUIRE(list.GetPrev(node3) == nullptr);
+    REQUIRE(list.GetPrev(node4) == node1);
+    REQUIRE(list.GetPrev(node2) == node4);
+    REQUIRE(list.CheckConsistence(4));
+}
+
+TEMPLATE_TEST_CASE("marked node list, deleted node keeps its successor", "[marked]",
+                   (std::tuple<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+
+    ListType list;
+    shared_ptr<NodeType> node1(new NodeType(1));
+    shared_ptr<NodeType> node2(new NodeType(2));
+    shared_ptr<NodeType> node3(new NodeType(3));
+    list.Append(node1);
+    list.Append(node2);
+    list.Append(node3);
+
+    REQUIRE(list.Remove(node2));
+    REQUIRE(node2->isDeleted());
+    REQUIRE(node2->Next() == node3);
+    REQUIRE_FALSE(list.Remove(node2));
+    REQUIRE(list.GetNext(node1) == node3);
+    REQUIRE(list.GetPrev(node3) == node1);
+
+    REQUIRE(list.PopTail() == node3);
+    REQUIRE(list.Tail() == node1);
+    REQUIRE(list.PopHead() == node1);
+    REQUIRE(list.Head() == nullptr);
+    REQUIRE(list.Tail() == nullptr);
+    REQUIRE(list.PopHead() == nullptr);
+    REQUIRE(list.CheckConsistence(0));
+}
+
+TEMPLATE_TEST_CASE("marked node list, multi-threads pop from both ends", "[marked]",
+                   (std::tuple<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+    const int threadNum = 8;
+    const int nodeNum = 4000;
+
+    ListType list;
+    for (int i = 0; i < nodeNum; i++)
+        list.Append(shared_ptr<NodeType>(new NodeType(i)));
+
+    std::vector<atomic<int>> popped(nodeNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            while (true) {
+                shared_ptr<NodeType> node = (t % 2 == 0) ? list.PopHead() : list.PopTail();
+                if (node == nullptr)
+                    break;
+                popped[node->data_].fetch_add(1);
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    int wrong = 0;
+    for (auto& count : popped)
+        if (count.load() != 1)
+            wrong++;
+    REQUIRE(wrong == 0);
+    REQUIRE(list.Head() == nullptr);
+    REQUIRE(list.CheckConsistence(0));
+}
+
+TEMPLATE_TEST_CASE("marked node list, multi-threads random insert and remove", "[marked]",
+                   (std::tuple<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+    const int threadNum = 8;
+    const int nodeNum = 1000;
+
+    ListType list;
+    std::vector<shared_ptr<NodeType>> nodes;
+    for (int i = 0; i < nodeNum; i++) {
+        nodes.push_back(shared_ptr<NodeType>(new NodeType(i)));
+        list.Append(nodes.back());
+    }
+
+    atomic<int> inserted(0);
+    atomic<int> removed(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            std::minstd_rand linearRand(t + 1);
+            std::uniform_int_distribution<int> distrib(0, 2 * nodeNum - 1);
+            for (int i = 0; i < nodeNum; i++) {
+                int index = distrib(linearRand);
+                if (index >= nodeNum) {
+                    if (list.Remove(nodes[index - nodeNum]))
+                        removed.fetch_add(1);
+                } else if (list.Insert(shared_ptr<NodeType>(new NodeType(index)), nodes[index])) {
+                    inserted.fetch_add(1);
+                }
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(list.CheckConsistence(nodeNum + inserted.load() - removed.load()));
+}
@@ -0,0 +1,127 @@
+#include "test_linkedlist.h"
+
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "epoch_reclaim.h"
+#include "hazard_pointer.h"
+#include "lockfree_pool.h"
+
+TEST_CASE("node pool, blocks are aligned and reused by the thread", "[pool]") {
+    NodePool* pool = NodePool::ForSize(40, false);
+    REQUIRE(pool == NodePool::ForSize(64, false));
+    REQUIRE(pool != NodePool::ForSize(65, false));
+    REQUIRE(NodePool::ForSize(NodePool::kSizeClasses * kCacheLineSize + 1, false) == nullptr);
+    REQUIRE(pool->BlockSize() == kCacheLineSize);
+
+    void* block = pool->Allocate();
+    REQUIRE(reinterpret_cast<uintptr_t>(block) % kCacheLineSize == 0);
+    pool->Free(block);
+    REQUIRE(pool->Allocate() == block);
+    pool->Free(block);
+}
+
+TEST_CASE("node pool, blocks move between threads through the depot", "[pool]") {
+    const int blockNum = 10000;
+    NodePool* pool = NodePool::ForSize(3 * kCacheLineSize, false);
+
+    std::vector<void*> blocks(blockNum);
+    std::thread producer([&]() {
+        for (auto& block : blocks)
+            block = pool->Allocate();
+    });
+    producer.join();
+    REQUIRE(std::set<void*>(blocks.begin(), blocks.end()).size() == blockNum);
+
+    std::thread consumer([&]() {
+        for (auto block : blocks)
+            pool->Free(block);
+    });
+    consumer.join();
+
+    size_t slabs = pool->SlabCount();
+    std::vector<void*> again(blockNum);
+    for (auto& block : again)
+        block = pool->Allocate();
+    REQUIRE(pool->SlabCount() == slabs);
+    for (auto block : again)
+        pool->Free(block);
+}
+
+TEST_CASE("node pool, huge page slabs are aligned to their size", "[pool]") {
+    NodePool* pool = NodePool::ForSize(3 * kCacheLineSize, true);
+    std::vector<void*> blocks(1000);
+    for (auto& block : blocks) {
+        block = pool->Allocate();
+        // the slab starts at a multiple of its size, the blocks at multiples of the block size from there
+        REQUIRE(reinterpret_cast<uintptr_t>(block) % NodePool::kHugeSlabBytes % pool->BlockSize() == 0);
+    }
+    for (auto block : blocks)
+        pool->Free(block);
+}
+
+// Allocates a block after the pool flushed the cache of the exiting thread, the block is kept in blocks
+struct ExitingAllocator {
+    NodePool* pool = nullptr;
+    std::vector<void*>* blocks = nullptr;
+    std::mutex* mutex = nullptr;
+
+    ~ExitingAllocator() {
+        if (pool == nullptr)
+            return;
+        void* block = pool->Allocate();
+        std::lock_guard<std::mutex> lock(*mutex);
+        blocks->push_back(block);
+    }
+};
+
+TEST_CASE("node pool, allocations of an exiting thread keep no cache", "[pool]") {
+    const int threadNum = 200;
+    NodePool* pool = NodePool::ForSize(5 * kCacheLineSize, false);
+    pool->Free(pool->Allocate());
+
+    size_t slabs = pool->SlabCount();
+    std::vector<void*> blocks;
+    std::mutex mutex;
+    for (int t = 0; t < threadNum; t++) {
+        std::thread([&]() {
+            // constructed before the cache flusher of the pool, so destroyed after it
+            static thread_local ExitingAllocator allocator;
+            allocator = ExitingAllocator{pool, &blocks, &mutex};
+            pool->Free(pool->Allocate());
+        }).join();
+    }
+    // the rest of a batch refilled into a flushed cache would be lost with the thread
+    REQUIRE(blocks.size() == threadNum);
+    REQUIRE(pool->SlabCount() == slabs);
+    for (auto block : blocks)
+        pool->Free(block);
+}
+
+TEST_CASE("node pool, lists of every reclamation policy", "[pool]") {
+    using SharedReclaim = PooledReclaim<SharedPtrReclaim>;
+    using SharedNode = LockFreeBiNode<int, SharedReclaim>;
+    LockFreeBiList<int, SharedReclaim> sharedList;
+    for (int i = 0; i < 1000; i++)
+        sharedList.Append(SharedReclaim::Make<SharedNode>(i));
+    REQUIRE(sharedList.PopHead()->data_ == 0);
+    REQUIRE(sharedList.CheckConsistence(999));
+
+    using EpochPool = PooledReclaim<EpochReclaim>;
+    LockFreeSiList<int, EpochPool> epochList;
+    for (int i = 0; i < 1000; i++)
+        epochList.Append(EpochPool::Make<LockFreeNode<int, EpochPool>>(i));
+    for (int i = 0; i < 500; i++)
+        epochList.PopHead();
+    EpochDomain::Instance().Flush();
+    REQUIRE(epochList.CheckConsistence(500));
+
+    using HazardPool = PooledReclaim<HazardPointerReclaim, true>;
+    LockFreeSiList<int, HazardPool> hazardList;
+    for (int i = 0; i < 1000; i++)
+        hazardList.Append(HazardPool::Make<LockFreeNode<int, HazardPool>>(i));
+    REQUIRE(hazardList.Head()->data_ == 0);
+    REQUIRE(hazardList.CheckConsistence(1000));
+}
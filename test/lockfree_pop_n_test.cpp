@@ -0,0 +1,93 @@
+#include "test_linkedlist.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+TEMPLATE_TEST_CASE("pop n, pop runs from the head and detach all", "[popn]",
+                   (std::tuple<LockFreeSiList<int>, LockFreeNode<int>>),
+                   (std::tuple<LockFreeBiList<int>, LockFreeBiNode<int>>),
+                   (std::tuple<LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>, LockFreeMarkedNode<int>>),
+                   (std::tuple<LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>, LockFreeMarkedBiNode<int>>)) {
+    using ListType = typename std::tuple_element<0, TestType>::type;
+    using NodeType = typename std::tuple_element<1, TestType>::type;
+
+    ListType list;
+    std::vector<shared_ptr<NodeType>> nodes;
+    REQUIRE(list.PopHeadN(4, nodes) == 0);
+    for (int i = 0; i < 10; i++)
+        list.Append(make_shared<NodeType>(i));
+
+    REQUIRE(list.PopHeadN(3, nodes) == 3);
+    REQUIRE(nodes.size() == 3);
+    for (int i = 0; i < 3; i++) {
+        REQUIRE(nodes[i]->data_ == i);
+        REQUIRE(nodes[i]->isDeleted());
+    }
+    REQUIRE(list.Head()->data_ == 3);
+    REQUIRE(list.GetPrev(list.Head()) == nullptr);
+    REQUIRE(list.CheckConsistence(7));
+
+    REQUIRE(list.PopHeadN(100, nodes) == 7);
+    REQUIRE(nodes.back()->data_ == 9);
+    REQUIRE(list.Head() == nullptr);
+    REQUIRE(list.Tail() == nullptr);
+    REQUIRE(list.CheckConsistence(0));
+
+    for (int i = 0; i < 5; i++)
+        list.Append(make_shared<NodeType>(i));
+    std::vector<shared_ptr<NodeType>> drained = list.DrainAll();
+    REQUIRE(drained.size() == 5);
+    REQUIRE(drained[4]->data_ == 4);
+    REQUIRE(list.Head() == nullptr);
+    REQUIRE(list.CheckConsistence(0));
+    list.Append(make_shared<NodeType>(5));
+    REQUIRE(list.Head() == list.Tail());
+    REQUIRE(list.CheckConsistence(1));
+}
+
+// The consumers pop runs while the producers append, every item is consumed once and every consumer sees the items
+// of a producer in order. The sentinel based deletion keeps one remover at the head, see README.
+TEMPLATE_TEST_CASE("pop n, multi-threads consuming runs while appending", "[popn]",
+                   (LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode>),
+                   (LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode>)) {
+    using NodePtr = typename TestType::NodePtr;
+    const int producerNum = 2;
+    const int consumerNum = 2;
+    const int loops = 4000;
+
+    TestType list;
+    std::atomic<int> producing(producerNum);
+    std::vector<std::vector<NodePtr>> consumed(consumerNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producerNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++)
+                list.Append(make_shared<typename TestType::NodeType>(t * loops + i));
+            producing--;
+        }));
+    }
+    for (int c = 0; c < consumerNum; c++) {
+        threads.push_back(std::thread([&, c]() {
+            while (producing > 0 || list.Head() != nullptr)
+                list.PopHeadN(c == 0 ? 16 : 3, consumed[c]);
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(list.CheckConsistence(0));
+    std::vector<int> seen(producerNum * loops, 0);
+    for (auto& nodes : consumed) {
+        std::vector<int> lastOfProducer(producerNum, -1);
+        for (auto& node : nodes) {
+            seen[node->data_]++;
+            int producer = node->data_ / loops;
+            REQUIRE(node->data_ > lastOfProducer[producer]);
+            lastOfProducer[producer] = node->data_;
+        }
+    }
+    REQUIRE(std::count(seen.begin(), seen.end(), 1) == producerNum * loops);
+}
@@ -0,0 +1,99 @@
+#include "test_linkedlist.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "epoch_reclaim.h"
+#include "hazard_pointer.h"
+#include "lockfree_pool.h"
+#include "lockfree_queue.h"
+
+TEMPLATE_TEST_CASE("queue, items leave in insertion order", "[queue]",
+                   LockFreeQueue<int>, (LockFreeQueue<int, HazardPointerReclaim>),
+                   (LockFreeQueue<int, EpochReclaim, NoCounter, PaddedLayout>)) {
+    TestType queue;
+    int value = -1;
+    REQUIRE(queue.Empty());
+    REQUIRE_FALSE(queue.TryDequeue(value));
+    for (int i = 0; i < 11; i++)
+        queue.Enqueue(i);
+    REQUIRE_FALSE(queue.Empty());
+
+    for (int i = 0; i < 6; i++) {
+        REQUIRE(queue.TryDequeue(value));
+        REQUIRE(value == i);
+    }
+    queue.Enqueue(11);
+    for (int i = 6; i < 12; i++) {
+        REQUIRE(queue.TryDequeue(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.TryDequeue(value));
+    REQUIRE(queue.Empty());
+    queue.Enqueue(12);
+    REQUIRE((queue.Size() == 1 || queue.Size() == -1)); // -1 with NoCounter
+}
+
+TEST_CASE("queue, nodes made by the caller", "[queue]") {
+    using Reclaim = PooledReclaim<EpochReclaim>;
+    LockFreeQueue<int, Reclaim> queue;
+    for (int i = 0; i < 100; i++)
+        queue.Enqueue(Reclaim::Make<LockFreeNode<int, Reclaim>>(i));
+    int value;
+    for (int i = 0; i < 100; i++) {
+        REQUIRE(queue.TryDequeue(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE(queue.Size() == 0);
+}
+
+// Every item is dequeued exactly once and every consumer sees the items of a producer in order
+TEMPLATE_TEST_CASE("queue, multi-threads producers and consumers", "[queue]",
+                   LockFreeQueue<int>, (LockFreeQueue<int, HazardPointerReclaim>),
+                   (LockFreeQueue<int, EpochReclaim, ExactCounter, PaddedLayout, ExponentialBackoff<>>)) {
+    const int producerNum = 3;
+    const int consumerNum = 3;
+    const int loops = 5000;
+
+    TestType queue;
+    std::atomic<int> producing(producerNum);
+    std::vector<std::vector<int>> consumed(consumerNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < producerNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++)
+                queue.Enqueue(t * loops + i);
+            producing--;
+        }));
+    }
+    for (int c = 0; c < consumerNum; c++) {
+        threads.push_back(std::thread([&, c]() {
+            int value;
+            while (true) {
+                bool done = producing == 0;
+                if (queue.TryDequeue(value))
+                    consumed[c].push_back(value);
+                else if (done)
+                    break;
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    REQUIRE(queue.Empty());
+    REQUIRE(queue.Size() == 0);
+    std::vector<int> seen(producerNum * loops, 0);
+    for (auto& values : consumed) {
+        std::vector<int> lastOfProducer(producerNum, -1);
+        for (int value : values) {
+            seen[value]++;
+            int producer = value / loops;
+            REQUIRE(value > lastOfProducer[producer]);
+            lastOfProducer[producer] = value;
+        }
+    }
+    REQUIRE(std::count(seen.begin(), seen.end(), 1) == producerNum * loops);
+}
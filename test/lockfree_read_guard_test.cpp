@@ -0,0 +1,121 @@
+#include "test_linkedlist.h"
+#include "epoch_reclaim.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+struct GuardedValue {
+    static atomic<int> alive;
+    int value;
+
+    GuardedValue(int v = 0) : value(v) { alive.fetch_add(1); }
+    GuardedValue(const GuardedValue& other) : value(other.value) { alive.fetch_add(1); }
+    ~GuardedValue() { alive.fetch_sub(1); }
+};
+
+atomic<int> GuardedValue::alive(0);
+
+TEST_CASE("read guard, walk a list with borrowed nodes", "[read_guard]") {
+    using NodeType = LockFreeBiNode<int, EpochReclaim>;
+    using SiNodeType = LockFreeNode<int, EpochReclaim>;
+    LockFreeBiList<int, EpochReclaim> list;
+    LockFreeSiList<int, EpochReclaim> siList;
+    for (int i = 0; i < 5; i++) {
+        list.Append(new NodeType(i));
+        siList.Append(new SiNodeType(i));
+    }
+
+    {
+        LockFreeBiList<int, EpochReclaim>::ReadGuard read(list);
+        int expected = 0;
+        for (const NodeType* node = read.Head(); node != nullptr; node = read.Next(node))
+            REQUIRE(node->data_ == expected++);
+        REQUIRE(expected == 5);
+        for (const NodeType* node = read.Tail(); node != nullptr; node = read.Prev(node))
+            REQUIRE(node->data_ == --expected);
+        REQUIRE(expected == 0);
+
+        // a borrowed node stays readable after its removal, the walk goes on from the node before it
+        const NodeType* second = read.Next(read.Head());
+        REQUIRE(list.Remove(list.GetNext(list.Head())));
+        REQUIRE(second->data_ == 1);
+        REQUIRE(read.Next(read.Head())->data_ == 2);
+    }
+    REQUIRE(list.CheckConsistence(4));
+
+    LockFreeSiList<int, EpochReclaim>::ReadGuard read(siList);
+    const SiNodeType* tail = read.Tail();
+    REQUIRE(tail->data_ == 4);
+    REQUIRE(read.Prev(tail)->data_ == 3);
+    REQUIRE(read.Next(tail) == nullptr);
+    REQUIRE(read.Next(nullptr) == nullptr);
+}
+
+TEST_CASE("read guard, borrowed nodes outlive their retirement", "[read_guard]") {
+    using NodeType = LockFreeNode<GuardedValue, EpochReclaim>;
+
+    int before = GuardedValue::alive.load();
+    {
+        LockFreeSiList<GuardedValue, EpochReclaim> list;
+        for (int i = 0; i < 3; i++)
+            list.Append(new NodeType(GuardedValue(i)));
+
+        {
+            LockFreeSiList<GuardedValue, EpochReclaim>::ReadGuard read(list);
+            const NodeType* head = read.Head();
+            // another thread pops and flushes, the node borrowed here is not freed
+            std::thread([&]() {
+                list.PopHead();
+                EpochDomain::Instance().Flush();
+            }).join();
+            REQUIRE(GuardedValue::alive.load() == before + 3);
+            REQUIRE(head->data_.value == 0);
+            REQUIRE(read.Head()->data_.value == 1);
+            REQUIRE(read.Next(read.Head())->data_.value == 2);
+        }
+        EpochDomain::Instance().Flush();
+        REQUIRE(GuardedValue::alive.load() == before + 2);
+    }
+    REQUIRE(GuardedValue::alive.load() == before);
+}
+
+// Readers walk with borrowed nodes while the list is popped and refilled
+TEST_CASE("read guard, multi-threads walk while popping", "[read_guard]") {
+    using NodeType = LockFreeNode<int, EpochReclaim>;
+    using ListType = LockFreeSiList<int, EpochReclaim>;
+    const int readerNum = 4;
+    const int nodeNum = 5000;
+
+    ListType list;
+    for (int i = 0; i < nodeNum; i++)
+        list.Append(new NodeType(i));
+
+    std::atomic<bool> done(false);
+    std::atomic<int> invalid(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < readerNum; t++) {
+        readers.push_back(std::thread([&]() {
+            while (!done.load()) {
+                ListType::ReadGuard read(list);
+                int last = -1;
+                for (auto node = read.Head(); node != nullptr; node = read.Next(node)) {
+                    if (node->data_ <= last || node->data_ >= 2 * nodeNum)
+                        invalid.fetch_add(1);
+                    last = node->data_;
+                }
+            }
+        }));
+    }
+
+    for (int i = 0; i < nodeNum; i++) {
+        list.PopHead();
+        list.Append(new NodeType(nodeNum + i));
+    }
+    done.store(true);
+    for (auto& reader : readers)
+        reader.join();
+
+    REQUIRE(invalid.load() == 0);
+    REQUIRE(list.CheckConsistence(nodeNum));
+}
@@ -0,0 +1,275 @@
+#include "test_linkedlist.h"
+#include "hazard_pointer.h"
+#include "epoch_reclaim.h"
+
+#include <thread>
+#include <vector>
+
+struct TrackedValue {
+    static atomic<int> alive;
+    int value;
+
+    TrackedValue(int v = 0) : value(v) { alive.fetch_add(1); }
+    TrackedValue(const TrackedValue& other) : value(other.value) { alive.fetch_add(1); }
+    ~TrackedValue() { alive.fetch_sub(1); }
+};
+
+atomic<int> TrackedValue::alive(0);
+
+TEST_CASE("hazard pointer reclaim, single list push, traverse and remove", "[reclaim]") {
+    using ListType = LockFreeSiList<int, HazardPointerReclaim>;
+    using NodeType = LockFreeNode<int, HazardPointerReclaim>;
+
+    ListType list;
+    HazardPtr<NodeType> node1(new NodeType(1));
+    HazardPtr<NodeType> node2(new NodeType(2));
+    HazardPtr<NodeType> node3(new NodeType(3));
+    list.Append(node1);
+    list.Append(node2);
+    list.InsertHead(node3);
+
+    REQUIRE(list.Head() == node3);
+    REQUIRE(list.Tail() == node2);
+    REQUIRE(list.GetNext(node3) == node1);
+    REQUIRE(list.GetNext(node1) == node2);
+    REQUIRE(list.GetPrev(node1) == node3);
+
+    REQUIRE(list.Remove(node1));
+    REQUIRE(list.GetNext(node3) == node2);
+    REQUIRE(list.CheckConsistence(2));
+}
+
+TEST_CASE("hazard pointer reclaim, bidirectional list push, traverse and pop", "[reclaim]") {
+    using ListType = LockFreeBiList<int, HazardPointerReclaim>;
+    using NodeType = LockFreeBiNode<int, HazardPointerReclaim>;
+
+    ListType list;
+    for (int i = 0; i < 5; i++)
+        list.Append(HazardPtr<NodeType>(new NodeType(i)));
+
+    int expected = 0;
+    for (HazardPtr<NodeType> node = list.Head(); node != nullptr; node = list.GetNext(node))
+        REQUIRE(node->data_ == expected++);
+    REQUIRE(expected == 5);
+    REQUIRE(list.GetPrev(list.Tail())->data_ == 3);
+
+    HazardPtr<NodeType> head = list.PopHead();
+    REQUIRE(head->data_ == 0);
+    HazardPtr<NodeType> tail = list.PopTail();
+    REQUIRE(tail->data_ == 4);
+    REQUIRE(list.CheckConsistence(3));
+}
+
+TEST_CASE("hazard pointer reclaim, retired node is kept while protected", "[reclaim]") {
+    using NodeType = LockFreeNode<TrackedValue, HazardPointerReclaim>;
+
+    int before = TrackedValue::alive.load();
+    {
+        LockFreeSiList<TrackedValue, HazardPointerReclaim> list;
+        list.Append(HazardPtr<NodeType>(new NodeType(TrackedValue(1))));
+        list.Append(HazardPtr<NodeType>(new NodeType(TrackedValue(2))));
+        REQUIRE(TrackedValue::alive.load() == before + 2);
+
+        HazardPtr<NodeType> head = list.PopHead();
+        HazardPointerDomain::Instance().Flush();
+        REQUIRE(TrackedValue::alive.load() == before + 2);
+        REQUIRE(head->data_.value == 1);
+
+        head = nullptr;
+        HazardPointerDomain::Instance().Flush();
+        REQUIRE(TrackedValue::alive.load() == before + 1);
+    }
+    // the list destructor frees the nodes still linked
+    REQUIRE(TrackedValue::alive.load() == before);
+}
+
+TEST_CASE("hazard pointer reclaim, multi-threads traverse while popping", "[reclaim]") {
+    using NodeType = LockFreeBiNode<TrackedValue, HazardPointerReclaim>;
+    const int readerNum = 8;
+    const int nodeNum = 20000;
+
+    int before = TrackedValue::alive.load();
+    {
+        LockFreeBiList<TrackedValue, HazardPointerReclaim> list;
+        for (int i = 0; i < nodeNum; i++)
+            list.Append(HazardPtr<NodeType>(new NodeType(TrackedValue(i))));
+
+        atomic<bool> done(false);
+        atomic<int> invalid(0);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < readerNum; t++) {
+            readers.push_back(std::thread([&]() {
+                while (!done.load()) {
+                    for (HazardPtr<NodeType> node = list.Head(); node != nullptr; node = list.GetNext(node)) {
+                        if (node->data_.value < 0 || node->data_.value >= nodeNum)
+                            invalid.fetch_add(1);
+                    }
+                }
+            }));
+        }
+
+        int popped = 0;
+        while (list.PopHead() != nullptr)
+            popped++;
+        done.store(true);
+        for (auto& reader : readers)
+            reader.join();
+
+        REQUIRE(invalid.load() == 0);
+        REQUIRE(popped == nodeNum);
+        REQUIRE(list.Head() == nullptr);
+    }
+    HazardPointerDomain::Instance().Flush();
+    REQUIRE(TrackedValue::alive.load() == before);
+}
+
+TEST_CASE("epoch reclaim, single list push, traverse and remove", "[reclaim]") {
+    using ListType = LockFreeSiList<int, EpochReclaim>;
+    using NodeType = LockFreeNode<int, EpochReclaim>;
+
+    ListType list;
+    EpochPtr<NodeType> node1(new NodeType(1));
+    EpochPtr<NodeType> node2(new NodeType(2));
+    EpochPtr<NodeType> node3(new NodeType(3));
+    list.Append(node1);
+    list.Append(node2);
+    list.InsertHead(node3);
+
+    ListType::Guard guard;
+    REQUIRE(list.Head() == node3);
+    REQUIRE(list.Tail() == node2);
+    REQUIRE(list.GetNext(node3) == node1);
+    REQUIRE(list.GetPrev(node2) == node1);
+
+    REQUIRE(list.Remove(node1));
+    REQUIRE(list.GetNext(node3) == node2);
+    REQUIRE(list.CheckConsistence(2));
+}
+
+TEST_CASE("epoch reclaim, retired node is kept while a guard is held", "[reclaim]") {
+    using NodeType = LockFreeBiNode<TrackedValue, EpochReclaim>;
+
+    int before = TrackedValue::alive.load();
+    {
+        LockFreeBiList<TrackedValue, EpochReclaim> list;
+        list.Append(new NodeType(TrackedValue(1)));
+        list.Append(new NodeType(TrackedValue(2)));
+        list.Append(new NodeType(TrackedValue(3)));
+        REQUIRE(TrackedValue::alive.load() == before + 3);
+
+        {
+            EpochGuard guard;
+            EpochPtr<NodeType> head = list.PopHead();
+            EpochDomain::Instance().Flush();
+            REQUIRE(TrackedValue::alive.load() == before + 3);
+            REQUIRE(head->data_.value == 1);
+        }
+        EpochDomain::Instance().Flush();
+        REQUIRE(TrackedValue::alive.load() == before + 2);
+
+        REQUIRE(list.PopTail()->data_.value == 3);
+        EpochDomain::Instance().Flush();
+        REQUIRE(TrackedValue::alive.load() == before + 1);
+    }
+    // the list destructor frees the nodes still linked
+    REQUIRE(TrackedValue::alive.load() == before);
+}
+
+TEST_CASE("epoch reclaim, multi-threads traverse while popping", "[reclaim]") {
+    using NodeType = LockFreeNode<TrackedValue, EpochReclaim>;
+    const int readerNum = 8;
+    const int nodeNum = 20000;
+
+    int before = TrackedValue::alive.load();
+    {
+        LockFreeSiList<TrackedValue, EpochReclaim> list;
+        for (int i = 0; i < nodeNum; i++)
+            list.Append(new NodeType(TrackedValue(i)));
+
+        atomic<bool> done(false);
+        atomic<int> invalid(0);
+        std::vector<std::thread> readers;
+        for (int t = 0; t < readerNum; t++) {
+            readers.push_back(std::thread([&]() {
+                while (!done.load()) {
+                    EpochGuard guard;
+                    for (EpochPtr<NodeType> node = list.Head(); node != nullptr; node = list.GetNext(node)) {
+                        if (node->data_.value < 0 || node->data_.value >= nodeNum)
+                            invalid.fetch_add(1);
+                    }
+                }
+            }));
+        }
+
+        int popped = 0;
+        while (list.PopHead() != nullptr)
+            popped++;
+        done.store(true);
+        for (auto& reader : readers)
+            reader.join();
+
+        REQUIRE(invalid.load() == 0);
+        REQUIRE(popped == nodeNum);
+        REQUIRE(list.Head() == nullptr);
+    }
+    EpochDomain::Instance().Flush();
+    REQUIRE(TrackedValue::alive.load() == before);
+}
+
+// Two threads pop the head and two remove the nodes they meet on their walks while a fifth appends, every removed
+// node is retired while the other removers may still search past it
+TEMPLATE_TEST_CASE("reclaim, multi-threads removers at the head and in the middle", "[reclaim]",
+                   (LockFreeSiList<TrackedValue, HazardPointerReclaim>),
+                   (LockFreeBiList<TrackedValue, HazardPointerReclaim>),
+                   (LockFreeSiList<TrackedValue, EpochReclaim>),
+                   (LockFreeBiList<TrackedValue, EpochReclaim>)) {
+    using NodeType = typename TestType::NodeType;
+    using NodePtr = typename TestType::NodePtr;
+    const int nodeNum = 10000;
+    const int total = 2 * nodeNum;
+
+    int before = TrackedValue::alive.load();
+    {
+        TestType list;
+        for (int i = 0; i < nodeNum; i++)
+            list.Append(NodePtr(new NodeType(TrackedValue(i))));
+
+        atomic<int> removed(0);
+        atomic<int> invalid(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 2; t++) {
+            threads.push_back(std::thread([&]() {
+                for (int i = 0; i < total / 4; i++) {
+                    if (list.PopHead() != nullptr)
+                        removed.fetch_add(1);
+                }
+            }));
+            threads.push_back(std::thread([&, t]() {
+                for (int round = 0; round < 4; round++) {
+                    typename TestType::Guard guard;
+                    NodePtr prevNode;
+                    for (NodePtr node = list.Head(); node != nullptr; node = list.GetNext(node)) {
+                        int value = node->data_.value;
+                        if (value < 0 || value >= total)
+                            invalid.fetch_add(1);
+                        else if (value % 4 == t && list.Remove(node, prevNode, false))
+                            removed.fetch_add(1);
+                        prevNode = node;
+                    }
+                }
+            }));
+        }
+        threads.push_back(std::thread([&]() {
+            for (int i = nodeNum; i < total; i++)
+                list.Append(NodePtr(new NodeType(TrackedValue(i))));
+        }));
+        for (auto& th : threads)
+            th.join();
+
+        REQUIRE(invalid.load() == 0);
+        REQUIRE(list.CheckConsistence(total - removed.load()));
+    }
+    EpochDomain::Instance().Flush();
+    HazardPointerDomain::Instance().Flush();
+    REQUIRE(TrackedValue::alive.load() == before);
+}
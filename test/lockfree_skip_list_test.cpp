@@ -0,0 +1,106 @@
+#include "test_linkedlist.h"
+
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lockfree_skip_list.h"
+
+TEST_CASE("skip list, insert, find, remove and level 0 traversal", "[skiplist]") {
+    LockFreeSkipList<int, std::string> map;
+    for (int key : {50, 10, 30, 90, 70})
+        REQUIRE(map.Insert(key, std::to_string(key)));
+    REQUIRE_FALSE(map.Insert(30, "again"));
+    REQUIRE(map.Size() == 5);
+
+    REQUIRE(map.Find(30)->Value() == "30");
+    REQUIRE(map.Find(40) == nullptr);
+    REQUIRE(map.Contains(90));
+    REQUIRE(map.LowerBound(40)->Key() == 50);
+    REQUIRE(map.LowerBound(100) == nullptr);
+
+    std::vector<int> keys;
+    for (auto node = map.Head(); node != nullptr; node = map.GetNext(node))
+        keys.push_back(node->Key());
+    REQUIRE(keys == std::vector<int>({10, 30, 50, 70, 90}));
+
+    REQUIRE(map.Remove(50)->Value() == "50");
+    REQUIRE(map.Remove(50) == nullptr);
+    REQUIRE_FALSE(map.Contains(50));
+    REQUIRE(map.LowerBound(40)->Key() == 70);
+    REQUIRE(map.CheckConsistence(4));
+}
+
+TEST_CASE("skip list, range scan", "[skiplist]") {
+    LockFreeSkipList<int, int> map;
+    for (int key = 0; key < 1000; key++)
+        map.Insert(make_shared<LockFreeSkipNode<int, int>>(key, key * 2));
+
+    std::vector<int> values;
+    size_t count = map.Scan(100, 105, [&](const shared_ptr<LockFreeSkipNode<int, int>>& node) {
+        values.push_back(node->Value());
+        return true;
+    });
+    REQUIRE(count == 5);
+    REQUIRE(values == std::vector<int>({200, 202, 204, 206, 208}));
+    REQUIRE(map.Scan(998, 2000, [](const shared_ptr<LockFreeSkipNode<int, int>>&) { return false; }) == 1);
+    REQUIRE(map.CheckConsistence(1000));
+}
+
+TEST_CASE("skip list, multi-threads insert and remove keys", "[skiplist]") {
+    const int threadNum = 8;
+    const int keyNum = 500;
+    const int loops = 4000;
+
+    LockFreeSkipList<int, int> map;
+    atomic<int> inserted(0);
+    atomic<int> removed(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            std::minstd_rand linearRand(t + 1);
+            std::uniform_int_distribution<int> distrib(0, keyNum - 1);
+            for (int i = 0; i < loops; i++) {
+                int key = distrib(linearRand);
+                if (i % 2 == 0) {
+                    if (map.Insert(key, t))
+                        inserted.fetch_add(1);
+                } else if (map.Remove(key) != nullptr) {
+                    removed.fetch_add(1);
+                }
+                map.Find(key);
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    int count = 0;
+    for (auto& node : map) {
+        REQUIRE(map.Find(node.Key()) != nullptr);
+        count++;
+    }
+    REQUIRE(count == inserted.load() - removed.load());
+    REQUIRE(map.CheckConsistence(count));
+}
+
+// the destructor must not release the chains recursively
+TEST_CASE("skip list, large map destroyed", "[skiplist]") {
+    const int keyNum = 300000;
+    {
+        LockFreeSkipList<int, int> map;
+        for (int i = 0; i < keyNum; i++)
+            map.Insert(i, i);
+        REQUIRE(map.Size() == keyNum);
+    }
+    {
+        LockFreeSiList<int, SharedPtrReclaim, LockFreeMarkedNode> list;
+        LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode> biList;
+        for (int i = 0; i < keyNum; i++) {
+            list.Emplace(i);
+            biList.Emplace(i);
+        }
+        REQUIRE(biList.CheckConsistence(keyNum));
+    }
+}
@@ -0,0 +1,93 @@
+#include "test_linkedlist.h"
+
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "lockfree_sorted_list.h"
+
+using SortedNode = LockFreeMarkedNode<int>;
+
+TEST_CASE("sorted list, insert, find and remove keys", "[sorted]") {
+    LockFreeSortedList<int> list;
+    for (int key : {5, 1, 3, 9, 7})
+        REQUIRE(list.InsertSorted(make_shared<SortedNode>(key)));
+    REQUIRE_FALSE(list.InsertSorted(make_shared<SortedNode>(3)));
+
+    std::vector<int> values;
+    for (auto& node : list)
+        values.push_back(node.data_);
+    REQUIRE(values == std::vector<int>({1, 3, 5, 7, 9}));
+
+    REQUIRE(list.Contains(7));
+    REQUIRE_FALSE(list.Contains(4));
+    REQUIRE(list.Find(5)->data_ == 5);
+    REQUIRE(list.Find(10) == nullptr);
+    REQUIRE(list.LowerBound(4)->data_ == 5);
+    REQUIRE(list.LowerBound(0)->data_ == 1);
+    REQUIRE(list.LowerBound(10) == nullptr);
+
+    REQUIRE(list.RemoveKey(5)->data_ == 5);
+    REQUIRE(list.RemoveKey(5) == nullptr);
+    REQUIRE(list.LowerBound(4)->data_ == 7);
+    REQUIRE(list.PopHead()->data_ == 1);
+    REQUIRE(list.CheckConsistence(3));
+}
+
+TEST_CASE("sorted list, duplicates and comparator", "[sorted]") {
+    LockFreeSortedList<int, std::greater<int>> list;
+    shared_ptr<SortedNode> first = make_shared<SortedNode>(2);
+    shared_ptr<SortedNode> second = make_shared<SortedNode>(2);
+    REQUIRE(list.InsertSorted(make_shared<SortedNode>(1), false));
+    REQUIRE(list.InsertSorted(first, false));
+    REQUIRE(list.InsertSorted(make_shared<SortedNode>(3), false));
+    REQUIRE(list.InsertSorted(second, false));
+
+    REQUIRE(list.Head()->data_ == 3);
+    REQUIRE(list.Find(2) == first);
+    REQUIRE(list.GetNext(first) == second);
+    REQUIRE(list.RemoveKey(2) == first);
+    REQUIRE(list.Find(2) == second);
+    REQUIRE(list.CheckConsistence(3));
+}
+
+TEST_CASE("sorted list, multi-threads insert and remove keys", "[sorted]") {
+    const int threadNum = 8;
+    const int keyNum = 200;
+    const int loops = 2000;
+
+    LockFreeSortedList<int> list;
+    atomic<int> inserted(0);
+    atomic<int> removed(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            std::minstd_rand linearRand(t + 1);
+            std::uniform_int_distribution<int> distrib(0, keyNum - 1);
+            for (int i = 0; i < loops; i++) {
+                int key = distrib(linearRand);
+                if (i % 2 == 0) {
+                    if (list.InsertSorted(make_shared<SortedNode>(key)))
+                        inserted.fetch_add(1);
+                } else if (list.RemoveKey(key) != nullptr) {
+                    removed.fetch_add(1);
+                }
+                list.Contains(key);
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    int count = 0;
+    int last = -1;
+    bool unique = true;
+    for (auto& node : list) {
+        unique = unique && node.data_ > last;
+        last = node.data_;
+        count++;
+    }
+    REQUIRE(unique);
+    REQUIRE(count == inserted.load() - removed.load());
+    REQUIRE(list.CheckConsistence(count));
+}
@@ -0,0 +1,85 @@
+#include "test_linkedlist.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "lockfree_stack.h"
+
+TEST_CASE("stack, nodes leave in reverse order", "[stack]") {
+    using NodeType = LockFreeStack<int>::NodeType;
+    LockFreeStack<int> stack;
+    REQUIRE(stack.Pop() == nullptr);
+    for (int i = 0; i < 10; i++)
+        stack.Push(make_shared<NodeType>(i));
+    REQUIRE(stack.CheckConsistence(10));
+    for (int i = 9; i >= 5; i--)
+        REQUIRE(stack.Pop()->data_ == i);
+    stack.Push(make_shared<NodeType>(10));
+    REQUIRE(stack.Pop()->data_ == 10);
+    REQUIRE(stack.CheckConsistence(5));
+    for (int i = 4; i >= 0; i--)
+        REQUIRE(stack.Pop()->data_ == i);
+    REQUIRE(stack.Pop() == nullptr);
+    REQUIRE(stack.CheckConsistence(0));
+}
+
+namespace {
+
+struct EliminationStack : LockFreeStack<int, SharedPtrReclaim, ExactCounter, CompactLayout, 1, 4096> {
+    using LockFreeStack::offer;
+    using LockFreeStack::take;
+};
+
+}
+
+TEST_CASE("stack, a pop takes the node offered by a push", "[stack]") {
+    EliminationStack stack;
+    auto node = make_shared<EliminationStack::NodeType>(1);
+    std::thread pusher([&]() {
+        while (!stack.offer(node)) {}
+    });
+    EliminationStack::NodePtr taken;
+    while (taken == nullptr)
+        taken = stack.take();
+    pusher.join();
+    REQUIRE(taken == node);
+    REQUIRE(stack.take() == nullptr);
+    REQUIRE(stack.CheckConsistence(0));
+}
+
+// Every thread pushes and pops on the same head, the colliding pairs meet in the elimination array:
+// a popped node was pushed and no node is popped twice
+TEST_CASE("stack, multi-threads symmetric push and pop", "[stack]") {
+    using NodePtr = LockFreeStack<int>::NodePtr;
+    const int threadNum = 6;
+    const int loops = 5000;
+
+    LockFreeStack<int, SharedPtrReclaim, ExactCounter, CompactLayout, 2, 1024> stack;
+    std::vector<std::vector<int>> popped(threadNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++) {
+                stack.Push(make_shared<LockFreeStack<int>::NodeType>(t * loops + i));
+                if (i % 4 != 0) {
+                    NodePtr node = stack.Pop();
+                    if (node != nullptr)
+                        popped[t].push_back(node->data_);
+                }
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    std::vector<int> seen(threadNum * loops, 0);
+    for (auto& values : popped)
+        for (int value : values)
+            seen[value]++;
+    REQUIRE(stack.CheckConsistence(threadNum * loops - std::count(seen.begin(), seen.end(), 1)));
+    NodePtr node;
+    while ((node = stack.Pop()) != nullptr)
+        seen[node->data_]++;
+    REQUIRE(std::count(seen.begin(), seen.end(), 1) == threadNum * loops);
+}
@@ -0,0 +1,101 @@
+#include "test_linkedlist.h"
+
+#include <thread>
+#include <vector>
+
+#include "lockfree_stats.h"
+
+TEST_CASE("stats policies, walks of the list", "[stats]") {
+    using StatsList = LockFreeSiList<int, SharedPtrReclaim, LockFreeNode, ExactCounter, CompactLayout, NoBackoff,
+                                     ContentionStats>;
+    using MarkedStatsList = LockFreeBiList<int, SharedPtrReclaim, LockFreeMarkedBiNode, ExactCounter, CompactLayout,
+                                           NoBackoff, ContentionStats>;
+    LockFreeSiList<int> list;
+    StatsList statsList;
+    MarkedStatsList markedList;
+    std::vector<shared_ptr<LockFreeNode<int>>> nodes;
+    for (int i = 0; i < 10; i++) {
+        nodes.push_back(make_shared<LockFreeNode<int>>(i));
+        statsList.Append(nodes.back());
+        list.Append(make_shared<LockFreeNode<int>>(i));
+        markedList.Append(make_shared<LockFreeMarkedBiNode<int>>(i));
+    }
+    REQUIRE(statsList.Remove(nodes.back()));
+    list.PopTail();
+    REQUIRE(markedList.Remove(markedList.Tail(), false));
+
+    // the predecessor of the tail is searched from the head of the singly linked list
+    ListStats stats = statsList.Stats();
+    const ListStats::Walks& prevWalks = stats.Walk(ListWalk::kValidPrev);
+    REQUIRE(prevWalks.count >= 1);
+    REQUIRE(prevWalks.steps >= 8);
+    REQUIRE(prevWalks.buckets[ListStats::WalkBucket(8)] >= 1);
+    for (int i = 0; i < ListStats::kEventCount; i++)
+        REQUIRE(stats.events[i] == 0);
+
+    // nothing is counted without a statistics policy
+    ListStats noStats = list.Stats();
+    for (int i = 0; i < ListStats::kWalkCount; i++)
+        REQUIRE(noStats.walks[i].count == 0);
+
+    // the marked list searches from its tail_ hint
+    REQUIRE(markedList.Stats().Walk(ListWalk::kLocate).count >= 10);
+    REQUIRE(markedList.CheckConsistence(9));
+}
+
+TEST_CASE("stats policies, contention stats sum every thread", "[stats]") {
+    const int threadNum = 40;
+    const int countNum = 1000;
+
+    ContentionStats stats;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < countNum; i++) {
+                stats.Count(t % 2 == 0 ? ListEvent::kNextCasFailure : ListEvent::kFixDelete);
+                stats.Walk(ListWalk::kValidNext, i % 4);
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    ListStats snapshot = stats.Snapshot();
+    REQUIRE(snapshot.Count(ListEvent::kNextCasFailure) == threadNum / 2 * countNum);
+    REQUIRE(snapshot.Count(ListEvent::kFixDelete) == threadNum / 2 * countNum);
+    REQUIRE(snapshot.Count(ListEvent::kFixInsert) == 0);
+    const ListStats::Walks& walks = snapshot.Walk(ListWalk::kValidNext);
+    REQUIRE(walks.count == threadNum * countNum);
+    REQUIRE(walks.steps == threadNum * countNum / 4 * (0 + 1 + 2 + 3));
+    REQUIRE(walks.buckets[0] == threadNum * countNum / 4);
+    REQUIRE(walks.buckets[1] == threadNum * countNum / 4);
+    REQUIRE(walks.buckets[2] == threadNum * countNum / 2);
+    REQUIRE(walks.MeanSteps() == 1.5);
+    REQUIRE(ListStats::WalkBucket(1u << 20) == ListStats::kWalkBuckets - 1);
+}
+
+// Concurrent appenders and a popper on a default list with every event counted
+TEST_CASE("stats policies, contended list", "[stats]") {
+    using StatsList = LockFreeBiList<int, SharedPtrReclaim, LockFreeBiNode, ExactCounter, CompactLayout, NoBackoff,
+                                     ContentionStats>;
+    const int threadNum = 4;
+    const int loops = 5000;
+
+    StatsList list;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadNum; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (int i = 0; i < loops; i++) {
+                list.Append(make_shared<LockFreeBiNode<int>>(t * loops + i));
+                while (t == 0 && list.PopHead() == nullptr) {}
+            }
+        }));
+    }
+    for (auto& th : threads)
+        th.join();
+
+    ListStats stats = list.Stats();
+    REQUIRE(list.CheckConsistence(threadNum * loops - loops));
+    // A pop searches the predecessor of its node, unless another thread unlinked the node for it first
+    REQUIRE(stats.Walk(ListWalk::kValidPrev).count + stats.Count(ListEvent::kHelpUnlink) >= uint64_t(loops));
+}